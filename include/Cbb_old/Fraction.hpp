@@ -1,8 +1,11 @@
 #pragma once
 
+#include <charconv>
+#include <climits>
 #include <istream>
 #include <numeric>
 #include <ostream>
+#include <string_view>
 #include <utility>
 
 
@@ -55,12 +58,20 @@ constexpr bool operator<=(const Fraction& left, const Fraction& right) noexcept;
 constexpr bool operator>(const Fraction& left, const Fraction& right) noexcept;
 constexpr bool operator>=(const Fraction& left, const Fraction& right) noexcept;
 
+// Three-way comparison of the values of two defined fractions: negative if left is lesser, zero if
+// they are equivalent and positive if left is greater. Never overflows.
+constexpr int compare(const Fraction& left, const Fraction& right) noexcept;
+
 constexpr bool symbolicallyEqual(const Fraction& left, const Fraction& right) noexcept;
 constexpr bool notSymbolicallyEqual(const Fraction& left, const Fraction& right) noexcept;
 
 constexpr long long numerator(const Fraction& fraction) noexcept;
 constexpr long long denominator(const Fraction& fraction) noexcept;
 
+// Greatest common divisor by Stein's binary algorithm, which trades std::gcd's divisions for shifts.
+// Duration denominators are mostly powers of two, which it strips in a single step.
+constexpr long long binaryGcd(long long a, long long b) noexcept;
+
 constexpr Fraction reduce(const Fraction& fraction) noexcept;
 
 constexpr Fraction reciprocalOf(const Fraction& fraction) noexcept;
@@ -89,6 +100,32 @@ constexpr bool isDefined(const Fraction& fraction) noexcept;
 constexpr bool isUndefined(const Fraction& fraction) noexcept;
 
 
+// Longest text toChars can write for a Fraction, i.e. "-9223372036854775808/-9223372036854775808"
+constexpr std::size_t maxFractionChars = 41;
+
+// Parses "n/d" or an integer "n" from the start of the text, without allocating or skipping
+// whitespace. As with std::from_chars, ptr points past the parsed characters, and ec is
+// std::errc::invalid_argument if there is no fraction or std::errc::result_out_of_range if a term
+// does not fit in a long long. The fraction is only assigned on success.
+std::from_chars_result fromChars(const char* first, const char* last, Fraction& fraction) noexcept;
+std::from_chars_result fromChars(std::string_view text, Fraction& fraction) noexcept;
+
+// Writes "n/d", with ec std::errc::value_too_large if it does not fit
+std::to_chars_result toChars(char* first, char* last, const Fraction& fraction) noexcept;
+
+
+// Magnitude at which boundedSum reduces its operands and result. Keeping every term below 2^31
+// guarantees that the cross products over a least common denominator fit in a long long.
+constexpr long long fractionReductionThreshold = 1LL << 31;
+
+constexpr bool exceedsReductionThreshold(const Fraction& fraction) noexcept;
+
+// Adds over the least common multiple of the denominators rather than their product, and only
+// reduces once a magnitude passes fractionReductionThreshold
+constexpr Fraction boundedSum(const Fraction& augend, const Fraction& addend) noexcept;
+constexpr Fraction boundedDifference(const Fraction& minuend, const Fraction& subtrahend) noexcept;
+
+
 class UnitFraction final {
 
 public:
@@ -103,6 +140,8 @@ private:
 };
 
 
+// A whole part and a fractional part in [0, 1) that takes the sign of the whole part, e.g. -5 4/5
+// is -29/5. A value in (-1, 1) has a zero whole part, so its fractional part carries its sign.
 class MixedFraction final {
 
 public:
@@ -123,6 +162,42 @@ private:
     Fraction fractionalPart_;
 };
 
+// Longest text toChars can write for a MixedFraction
+constexpr std::size_t maxMixedFractionChars = 21 + maxFractionChars;
+
+// Parses "w n/d", "n/d" or an integer "w" in the same manner as fromChars for a Fraction. The
+// fractional part is only consumed when a whole part is followed by a single space and "n/d". A
+// zero whole part takes the sign of itself or of the fractional part, as in "-0 1/3" or "0 -1/3".
+std::from_chars_result fromChars(const char* first,
+                                 const char* last,
+                                 MixedFraction& mixedFraction) noexcept;
+std::from_chars_result fromChars(std::string_view text, MixedFraction& mixedFraction) noexcept;
+
+// Writes "w n/d", just "w" if the fractional part is zero, or a signed "n/d" if the whole part is
+// zero, so that values in (-1, 1) keep their sign
+std::to_chars_result toChars(char* first, char* last, const MixedFraction& mixedFraction) noexcept;
+
+
+// Running sum of many fractions (e.g. the durations in a bar) that stays bounded in magnitude
+class FractionAccumulator final {
+
+public:
+    constexpr FractionAccumulator() noexcept = default;
+    constexpr FractionAccumulator(const Fraction& initialValue) noexcept;
+
+    constexpr FractionAccumulator& add(const Fraction& addend) noexcept;
+    constexpr FractionAccumulator& subtract(const Fraction& subtrahend) noexcept;
+
+    constexpr FractionAccumulator& operator+=(const Fraction& addend) noexcept;
+    constexpr FractionAccumulator& operator-=(const Fraction& subtrahend) noexcept;
+
+    constexpr Fraction total() const noexcept { return reduce(sum_); }
+    constexpr operator Fraction() const noexcept { return total(); }
+
+private:
+    Fraction sum_;
+};
+
 
 // =================================================================================================
 
@@ -229,12 +304,147 @@ constexpr Fraction& operator%=(Fraction& dividend, const Fraction& divisor) noex
     return dividend = dividend % divisor;
 }
 
+namespace detail {
+
+constexpr int countTrailingZeros(const unsigned long long value) noexcept
+{
+#if defined(__GNUC__)
+    return __builtin_ctzll(value);
+#else
+    auto result = 0;
+
+    for (auto remaining = value; (remaining & 1ULL) == 0; remaining >>= 1)
+        ++result;
+
+    return result;
+#endif
+}
+
+constexpr bool isPow2(const long long value) noexcept
+{
+    return value > 0 && (value & (value - 1)) == 0;
+}
+
+constexpr int threeWay(const long long left, const long long right) noexcept
+{
+    return (left < right) ? -1 : (left > right) ? 1 : 0;
+}
+
+// Both denominators must be positive
+constexpr int compareWithPow2Denominators(const Fraction& left, const Fraction& right) noexcept
+{
+    const auto leftShift = countTrailingZeros(static_cast<unsigned long long>(left.denominator()));
+    const auto rightShift =
+        countTrailingZeros(static_cast<unsigned long long>(right.denominator()));
+
+    // Scale the numerator with the smaller denominator up to the larger one, saturating to the
+    // sign of the scaled numerator where the shift would overflow
+    const auto compareScaled = [](const long long numerator,
+                                  const int shift,
+                                  const long long other) {
+        const auto limit = LLONG_MAX >> shift;
+
+        if (numerator > limit)
+            return 1;
+
+        if (numerator < -limit)
+            return -1;
+
+        return threeWay(numerator * (1LL << shift), other);
+    };
+
+    if (leftShift <= rightShift)
+        return compareScaled(left.numerator(), rightShift - leftShift, right.numerator());
+
+    return -compareScaled(right.numerator(), leftShift - rightShift, left.numerator());
+}
+
+#if defined(__SIZEOF_INT128__)
+
+// Both denominators must be positive
+constexpr int compareByWideningMultiply(const Fraction& left, const Fraction& right) noexcept
+{
+    const auto leftProduct = static_cast<__int128>(left.numerator()) * right.denominator();
+    const auto rightProduct = static_cast<__int128>(right.numerator()) * left.denominator();
+
+    return (leftProduct < rightProduct) ? -1 : (leftProduct > rightProduct) ? 1 : 0;
+}
+
+#endif
+
+// Both denominators must be positive. Compares the continued fraction expansions term by term so
+// that no intermediate value exceeds the magnitude of the inputs.
+constexpr int compareByContinuedFraction(const Fraction& left, const Fraction& right) noexcept
+{
+    const auto leftSign = threeWay(left.numerator(), 0);
+    const auto rightSign = threeWay(right.numerator(), 0);
+
+    if (leftSign != rightSign || leftSign == 0)
+        return threeWay(leftSign, rightSign);
+
+    // Both have the same sign, so compare magnitudes and flip the result if negative
+    auto a = (leftSign > 0) ? left.numerator() : -left.numerator();
+    auto b = left.denominator();
+    auto c = (rightSign > 0) ? right.numerator() : -right.numerator();
+    auto d = right.denominator();
+    auto orientation = leftSign;
+
+    while (true)
+    {
+        const auto leftQuotient = a / b;
+        const auto rightQuotient = c / d;
+
+        if (leftQuotient != rightQuotient)
+            return orientation * threeWay(leftQuotient, rightQuotient);
+
+        const auto leftRemainder = a % b;
+        const auto rightRemainder = c % d;
+
+        if (leftRemainder == 0 || rightRemainder == 0)
+            return orientation * threeWay(leftRemainder, rightRemainder);
+
+        // With a/b = q + r/b and c/d = q + r'/d, a/b < c/d exactly when b/r > d/r'
+        a = b;
+        b = leftRemainder;
+        c = d;
+        d = rightRemainder;
+        orientation = -orientation;
+    }
+}
+
+} // namespace detail
+
+constexpr int compare(const Fraction& left, const Fraction& right) noexcept
+{
+    if (left.denominator() == right.denominator())
+        return (left.denominator() > 0) ? detail::threeWay(left.numerator(), right.numerator())
+                                        : detail::threeWay(right.numerator(), left.numerator());
+
+    const auto normalize = [](const Fraction& fraction) {
+        return (fraction.denominator() < 0)
+                   ? Fraction(-fraction.numerator(), -fraction.denominator())
+                   : fraction;
+    };
+
+#if defined(__SIZEOF_INT128__)
+    return detail::compareByWideningMultiply(normalize(left), normalize(right));
+#else
+    const auto l = normalize(left);
+    const auto r = normalize(right);
+
+    if (detail::isPow2(l.denominator()) && detail::isPow2(r.denominator()))
+        return detail::compareWithPow2Denominators(l, r);
+
+    return detail::compareByContinuedFraction(l, r);
+#endif
+}
+
 constexpr bool operator==(const Fraction& left, const Fraction& right) noexcept
 {
     if (isUndefined(left) || isUndefined(right))
         return false;
 
-    return left.numerator() * right.denominator() == right.numerator() * left.denominator();
+    return compare(left, right) == 0;
 }
 
 constexpr bool operator!=(const Fraction& left, const Fraction& right) noexcept
@@ -247,7 +457,7 @@ constexpr bool operator<(const Fraction& left, const Fraction& right) noexcept
     if (isUndefined(left) || isUndefined(right))
         return false;
 
-    return left.numerator() * right.denominator() < right.numerator() * left.denominator();
+    return compare(left, right) < 0;
 }
 
 constexpr bool operator<=(const Fraction& left, const Fraction& right) noexcept
@@ -255,7 +465,7 @@ constexpr bool operator<=(const Fraction& left, const Fraction& right) noexcept
     if (isUndefined(left) || isUndefined(right))
         return false;
 
-    return left.numerator() * right.denominator() <= right.numerator() * left.denominator();
+    return compare(left, right) <= 0;
 }
 
 constexpr bool operator>(const Fraction& left, const Fraction& right) noexcept
@@ -263,7 +473,7 @@ constexpr bool operator>(const Fraction& left, const Fraction& right) noexcept
     if (isUndefined(left) || isUndefined(right))
         return false;
 
-    return left.numerator() * right.denominator() > right.numerator() * left.denominator();
+    return compare(left, right) > 0;
 }
 
 constexpr bool operator>=(const Fraction& left, const Fraction& right) noexcept
@@ -271,7 +481,7 @@ constexpr bool operator>=(const Fraction& left, const Fraction& right) noexcept
     if (isUndefined(left) || isUndefined(right))
         return false;
 
-    return left.numerator() * right.denominator() >= right.numerator() * left.denominator();
+    return compare(left, right) >= 0;
 }
 
 constexpr bool symbolicallyEqual(const Fraction& left, const Fraction& right) noexcept
@@ -294,9 +504,49 @@ constexpr long long denominator(const Fraction& fraction) noexcept
     return fraction.denominator();
 }
 
+constexpr long long binaryGcd(const long long a, const long long b) noexcept
+{
+    const auto magnitude = [](const long long value) {
+        return (value < 0) ? 0ULL - static_cast<unsigned long long>(value)
+                           : static_cast<unsigned long long>(value);
+    };
+
+    auto u = magnitude(a);
+    auto v = magnitude(b);
+
+    if (u == 0)
+        return static_cast<long long>(v);
+
+    if (v == 0)
+        return static_cast<long long>(u);
+
+    const auto commonShift = detail::countTrailingZeros(u | v);
+
+    u >>= detail::countTrailingZeros(u);
+    v >>= detail::countTrailingZeros(v);
+
+    // A power of two operand leaves 1 here, which is the common case for durations
+    while (u != v && u != 1 && v != 1)
+    {
+        if (u > v)
+        {
+            const auto smaller = v;
+            v = u;
+            u = smaller;
+        }
+
+        v -= u;
+        v >>= detail::countTrailingZeros(v);
+    }
+
+    u = (u < v) ? u : v;
+
+    return static_cast<long long>(u << commonShift);
+}
+
 constexpr Fraction reduce(const Fraction& fraction) noexcept
 {
-    const auto gcd = std::gcd(fraction.numerator(), fraction.denominator());
+    const auto gcd = binaryGcd(fraction.numerator(), fraction.denominator());
 
     return Fraction(fraction.numerator() / gcd, fraction.denominator() / gcd)
         .withMinimalNegativeSigns();
@@ -332,7 +582,7 @@ constexpr long long ceil(const Fraction& fraction) noexcept
     if (isInteger(fraction))
         return truncated;
 
-    return (truncated >= 0) ? truncated + 1 : truncated;
+    return isNegative(fraction) ? truncated : truncated + 1;
 }
 
 constexpr long long floor(const Fraction& fraction) noexcept
@@ -342,7 +592,7 @@ constexpr long long floor(const Fraction& fraction) noexcept
     if (isInteger(fraction))
         return truncated;
 
-    return (truncated >= 0) ? truncated : truncated - 1;
+    return isNegative(fraction) ? truncated - 1 : truncated;
 }
 
 constexpr long long trunc(const Fraction& fraction) noexcept
@@ -404,6 +654,45 @@ constexpr bool isUndefined(const Fraction& fraction) noexcept
     return !isDefined(fraction);
 }
 
+constexpr bool exceedsReductionThreshold(const Fraction& fraction) noexcept
+{
+    const auto exceeds = [](const long long value) {
+        return value >= fractionReductionThreshold || value <= -fractionReductionThreshold;
+    };
+
+    return exceeds(fraction.numerator()) || exceeds(fraction.denominator());
+}
+
+constexpr Fraction boundedSum(const Fraction& augend, const Fraction& addend) noexcept
+{
+    if (isUndefined(augend) || isUndefined(addend))
+        return augend + addend;
+
+    const auto prepare = [](const Fraction& fraction) {
+        const auto normalized = (fraction.denominator() < 0)
+                                    ? Fraction(-fraction.numerator(), -fraction.denominator())
+                                    : fraction;
+
+        return exceedsReductionThreshold(normalized) ? reduce(normalized) : normalized;
+    };
+
+    const auto left = prepare(augend);
+    const auto right = prepare(addend);
+
+    const auto commonDenominator = std::lcm(left.denominator(), right.denominator());
+
+    const auto sum = Fraction(left.numerator() * (commonDenominator / left.denominator())
+                                  + right.numerator() * (commonDenominator / right.denominator()),
+                              commonDenominator);
+
+    return exceedsReductionThreshold(sum) ? reduce(sum) : sum;
+}
+
+constexpr Fraction boundedDifference(const Fraction& minuend, const Fraction& subtrahend) noexcept
+{
+    return boundedSum(minuend, -subtrahend);
+}
+
 constexpr UnitFraction::UnitFraction(const long long denominator) noexcept :
     denominator_ {denominator}
 {
@@ -417,7 +706,7 @@ constexpr MixedFraction::MixedFraction(const long long wholePart,
 
 constexpr MixedFraction::MixedFraction(const Fraction& fraction) noexcept :
     wholePart_ {trunc(fraction)},
-    fractionalPart_ {abs(fraction - wholePart_)}
+    fractionalPart_ {(wholePart_ == 0) ? fraction : abs(fraction - wholePart_)}
 {
 }
 
@@ -429,8 +718,38 @@ constexpr Fraction MixedFraction::asFraction() const noexcept
 constexpr Fraction MixedFraction::combine(const long long wholePart,
                                           const Fraction& fractionalPart) noexcept
 {
+    if (wholePart == 0)
+        return fractionalPart;
+
     return (wholePart > 0) ? wholePart + fractionalPart : wholePart - fractionalPart;
 }
 
+constexpr FractionAccumulator::FractionAccumulator(const Fraction& initialValue) noexcept :
+    sum_ {initialValue}
+{
+}
+
+constexpr FractionAccumulator& FractionAccumulator::add(const Fraction& addend) noexcept
+{
+    sum_ = boundedSum(sum_, addend);
+    return *this;
+}
+
+constexpr FractionAccumulator& FractionAccumulator::subtract(const Fraction& subtrahend) noexcept
+{
+    sum_ = boundedDifference(sum_, subtrahend);
+    return *this;
+}
+
+constexpr FractionAccumulator& FractionAccumulator::operator+=(const Fraction& addend) noexcept
+{
+    return add(addend);
+}
+
+constexpr FractionAccumulator& FractionAccumulator::operator-=(const Fraction& subtrahend) noexcept
+{
+    return subtract(subtrahend);
+}
+
 
 }; // namespace Cbb
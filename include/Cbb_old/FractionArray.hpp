@@ -0,0 +1,139 @@
+#pragma once
+
+#include <Cbb/Fraction.hpp>
+
+#include <cstddef>
+#include <initializer_list>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+
+namespace Cbb {
+
+
+namespace detail {
+
+// Allocates on boundaries suitable for aligned vector loads
+template <typename T, std::size_t Alignment>
+struct AlignedAllocator {
+    using value_type = T;
+
+    template <typename U>
+    struct rebind {
+        using other = AlignedAllocator<U, Alignment>;
+    };
+
+    constexpr AlignedAllocator() noexcept = default;
+
+    template <typename U>
+    constexpr AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept
+    {
+    }
+
+    T* allocate(const std::size_t size)
+    {
+        return static_cast<T*>(::operator new(size * sizeof(T), std::align_val_t {Alignment}));
+    }
+
+    void deallocate(T* const pointer, std::size_t) noexcept
+    {
+        ::operator delete(pointer, std::align_val_t {Alignment});
+    }
+
+    // Default-initializes rather than value-initializes, so that resizing an array that is about
+    // to be overwritten does not first fill it
+    template <typename U>
+    void construct(U* const pointer) noexcept(std::is_nothrow_default_constructible_v<U>)
+    {
+        ::new (static_cast<void*>(pointer)) U;
+    }
+
+    template <typename U, typename... Args>
+    void construct(U* const pointer, Args&&... args)
+    {
+        ::new (static_cast<void*>(pointer)) U(std::forward<Args>(args)...);
+    }
+
+    friend constexpr bool operator==(const AlignedAllocator&, const AlignedAllocator&) noexcept
+    {
+        return true;
+    }
+
+    friend constexpr bool operator!=(const AlignedAllocator&, const AlignedAllocator&) noexcept
+    {
+        return false;
+    }
+};
+
+} // namespace detail
+
+
+// A sequence of fractions stored as separate, 32 byte aligned arrays of numerators and
+// denominators, so that bulk operations over millions of onsets or durations can be vectorized.
+// The element-wise results are symbolically identical to those of the scalar Fraction operators.
+class FractionArray final {
+
+public:
+    static constexpr std::size_t alignment = 32;
+
+    using Terms = std::vector<long long, detail::AlignedAllocator<long long, alignment>>;
+
+    FractionArray() = default;
+    explicit FractionArray(std::size_t size, const Fraction& value = {});
+    FractionArray(std::initializer_list<Fraction> fractions);
+    explicit FractionArray(const std::vector<Fraction>& fractions);
+
+    std::size_t size() const noexcept { return numerators_.size(); }
+    bool empty() const noexcept { return numerators_.empty(); }
+
+    void reserve(std::size_t capacity);
+    void resize(std::size_t size, const Fraction& value = {});
+    void clear() noexcept;
+
+    void pushBack(const Fraction& fraction);
+
+    Fraction operator[](std::size_t index) const noexcept;
+    void set(std::size_t index, const Fraction& fraction) noexcept;
+
+    const long long* numerators() const noexcept { return numerators_.data(); }
+    long long* numerators() noexcept { return numerators_.data(); }
+    const long long* denominators() const noexcept { return denominators_.data(); }
+    long long* denominators() noexcept { return denominators_.data(); }
+
+    std::vector<Fraction> toVector() const;
+
+private:
+    struct Uninitialized {};
+
+    FractionArray(std::size_t size, Uninitialized);
+
+    friend FractionArray operator+(const FractionArray& augends, const FractionArray& addends);
+    friend FractionArray operator*(const FractionArray& multiplicands, const Fraction& multiplier);
+    friend FractionArray reduce(const FractionArray& fractions);
+
+    Terms numerators_;
+    Terms denominators_;
+};
+
+// Element-wise sums of two arrays of equal size
+FractionArray operator+(const FractionArray& augends, const FractionArray& addends);
+FractionArray& operator+=(FractionArray& augends, const FractionArray& addends);
+
+// Every element multiplied by the same fraction
+FractionArray operator*(const FractionArray& multiplicands, const Fraction& multiplier);
+FractionArray& operator*=(FractionArray& multiplicands, const Fraction& multiplier);
+
+// Whether each element is less than the threshold
+std::vector<bool> lessThan(const FractionArray& fractions, const Fraction& threshold);
+
+std::vector<long long> floor(const FractionArray& fractions);
+
+FractionArray reduce(const FractionArray& fractions);
+
+// Whether the bulk operations above run on AVX2 on this machine
+bool fractionArrayIsVectorized() noexcept;
+
+
+}; // namespace Cbb
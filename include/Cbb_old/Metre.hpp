@@ -4,8 +4,12 @@
 #include <Cbb/NoteValue.hpp>
 
 #include <chrono>
-#include <functional>
-#include <map>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <tuple>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 
@@ -54,6 +58,49 @@ constexpr bool operator>=(const MetricPosition& left, const MetricPosition& righ
 
 using TempoBpm = Fraction;
 
+// How the tempo moves from a BPM change to the next one. A linear ramp changes the BPM linearly in
+// time, which keeps the seconds it lasts, and the beats at any of them, rational. An exponential
+// ramp changes the BPM exponentially in time, which is linearly in beats, and lasts an irrational
+// number of seconds.
+enum class TempoRamp { none, linear, exponential };
+
+
+// A read-only view of a contiguous, ascending run of changes, standing in for std::span. It is
+// invalidated by the next modification of the metric structure it was taken from.
+template <typename Key, typename Value>
+class ChangeView final {
+
+public:
+    using Change = std::pair<Key, Value>;
+    using ConstIterator = const Change*;
+
+    constexpr ChangeView() noexcept = default;
+    constexpr ChangeView(const Change* first, std::size_t size) noexcept;
+
+    constexpr const Change& operator[](std::size_t index) const noexcept { return first_[index]; }
+
+    constexpr const Change& front() const noexcept { return first_[0]; }
+    constexpr const Change& back() const noexcept { return first_[size_ - 1]; }
+
+    constexpr const Change* data() const noexcept { return first_; }
+    constexpr std::size_t size() const noexcept { return size_; }
+    constexpr bool empty() const noexcept { return size_ == 0; }
+
+    constexpr ConstIterator begin() const noexcept { return first_; }
+    constexpr ConstIterator end() const noexcept { return first_ + size_; }
+
+private:
+    const Change* first_ = nullptr;
+    std::size_t size_ = 0;
+};
+
+using TimeSignatureChanges = ChangeView<BarNumber, TimeSignature>;
+using BpmChanges = ChangeView<MetricPosition, TempoBpm>;
+
+
+// The changes are kept in ascending vectors, so that looking one up is a binary search over
+// contiguous memory and listing them is a view rather than a copy. Adding a change after all the
+// others is amortized constant time; adding one earlier shifts the later ones.
 class MetricStructure final {
 
 public:
@@ -63,28 +110,377 @@ public:
 
     void addTimeSignatureChange(BarNumber bar, const TimeSignature& timeSignature);
 
-    void addBpmChange(const MetricPosition& position, const TempoBpm& bpm);
+    // A ramp goes from the BPM of the change to that of the next one, and has no effect on the last
+    // change
+    void addBpmChange(const MetricPosition& position,
+                      const TempoBpm& bpm,
+                      TempoRamp ramp = TempoRamp::none);
 
     bool eraseTimeSignatureChangeAt(BarNumber bar);
 
     bool eraseBpmChangeAt(const MetricPosition& position);
 
-    std::vector<std::pair<BarNumber, TimeSignature>> timeSignatureChanges() const;
+    // Replace the changes with those of a range, as if the metric structure were constructed anew
+    // and each change of the range added in turn. The range can be in any order; sorting it takes
+    // O(n log n), and checking that it is already sorted O(n). The derived tables are rebuilt once.
+    // Time signature changes are pairs of a bar and a time signature, and BPM changes pairs of a
+    // position and a BPM, or tuples that add a ramp.
+    template <typename InputIt>
+    void assignTimeSignatureChanges(InputIt first, InputIt last);
+
+    template <typename Changes>
+    void assignTimeSignatureChanges(const Changes& changes);
+
+    template <typename InputIt>
+    void assignBpmChanges(InputIt first, InputIt last);
+
+    template <typename Changes>
+    void assignBpmChanges(const Changes& changes);
 
-    std::vector<std::pair<MetricPosition, TempoBpm>> bpmChanges() const;
+    TimeSignatureChanges timeSignatureChanges() const noexcept;
 
+    BpmChanges bpmChanges() const noexcept;
+
+    // A position before the initial bar gets the initial change
     std::pair<BarNumber, TimeSignature>
     lastestTimeSignatureChange(const MetricPosition& position) const;
 
     std::pair<MetricPosition, TempoBpm> lastestBpmChange(const MetricPosition& position) const;
 
+    TempoRamp lastestBpmRamp(const MetricPosition& position) const noexcept;
+
+    // The BPM at the position, which within a ramp is between those of the changes around it
+    double approximateBpmAt(const MetricPosition& position) const noexcept;
+
+    // The seconds from the first BPM change, which is at the initial bar unless one was added
+    // before it. The beat of a position counts its time signature's beat units, as does a BPM.
+    // Each query is a binary search of the time signature and BPM changes and a few operations on
+    // the prefix sums kept with them. The seconds are exact as long as their terms fit in a
+    // Fraction, which a tempo map of many unrelated fractional BPMs can exceed. Throws
+    // std::domain_error where the seconds are irrational: within a ramp, past its start, and
+    // anywhere after an exponential ramp.
+    Fraction secondsAt(const MetricPosition& position) const;
+
+    // secondsAt in floating point, from prefix sums kept in floating point, so that it neither
+    // reduces any fraction nor overflows. Ramps are integrated in closed form.
+    double approximateSecondsAt(const MetricPosition& position) const noexcept;
+
+    // secondsAt for every position of an ascending range, in time linear in the number of
+    // positions and changes
+    template <typename InputIt, typename OutputIt>
+    OutputIt secondsAt(InputIt first, InputIt last, OutputIt dFirst) const;
+
+    // The inverse of secondsAt, with the exact beat within the bar. Throws std::domain_error within
+    // an exponential ramp, past its start, and after it.
+    MetricPosition positionAt(const Fraction& seconds) const;
+
+    static constexpr long long approximateBeatResolution = 1LL << 20;
+
+    // The inverse of approximateSecondsAt, with the beat rounded to the nearest
+    // 1/approximateBeatResolution
+    MetricPosition approximatePositionAt(double seconds) const;
+
+    // The whole notes from the start of the initial bar to the position, negative before it. With
+    // it, positions on either side of time signature changes can be subtracted and sorted.
+    Fraction offsetOf(const MetricPosition& position) const;
+
+    // The inverse of offsetOf, with the exact beat within the bar
+    MetricPosition positionAtOffset(const Fraction& wholeNotes) const;
+
+    class PositionStream;
+
+    // For timestamps that only increase, such as those of recorded input
+    PositionStream positionStream() const noexcept;
+
+    class Cursor;
+
+    // For positions that mostly move forward, such as a playhead's
+    Cursor cursor(const MetricPosition& position) const noexcept;
+
+    class BeatRange;
+
+    // The positions of the beats from one position to before another, each divided into the
+    // subdivision, and their approximate seconds. The range is lazy, and iterating it never
+    // allocates. Throws std::invalid_argument if the subdivision is not positive.
+    BeatRange beats(const MetricPosition& from, const MetricPosition& to, int subdivision = 1) const;
+
+    class BlockRenderer;
+
+    // For the blocks of samples of audio playback, from the sample at 0 seconds. Throws
+    // std::invalid_argument if the sample rate is not positive.
+    BlockRenderer blockRenderer(long long sampleRate, long long sample = 0) const;
+
 private:
+    // Where a time signature change falls, in beats and whole notes, and the whole notes of its
+    // beat unit
+    struct MeterSegment {
+        long long beats = 0;
+        Fraction wholeNotes;
+        Fraction beatLength;
+    };
+
+    // Where a BPM change falls, in beats and seconds, its reduced tempo in beats per second, the
+    // ramp to the next change, which is none for the last one, and their floating point
+    // counterparts. The seconds after an exponential ramp are irrational, and kept as
+    // unknownSeconds. The ramp rate is the acceleration in beats per second squared of a linear
+    // ramp, and the growth rate per second of an exponential one.
+    struct TempoSegment {
+        Fraction beats;
+        Fraction seconds;
+        Fraction beatsPerSecond;
+        Fraction beatsPerSecondSquared;
+        TempoRamp ramp = TempoRamp::none;
+        double approximateBeats = 0;
+        double approximateSeconds = 0;
+        double approximateSecondsPerBeat = 0;
+        double approximateBeatsPerSecond = 0;
+        double approximateRampRate = 0;
+    };
+
+    // Greater than any seconds, so that searching the seconds of the tempo segments ends at the
+    // last one that is known
+    static constexpr Fraction unknownSeconds = Fraction(std::numeric_limits<long long>::max());
+
+    long long beatsBefore(BarNumber bar, std::size_t timeSignatureIndex) const noexcept;
+    double approximateBeatsOf(const MetricPosition& position,
+                              std::size_t timeSignatureIndex) const noexcept;
+    Fraction wholeNotesBefore(BarNumber bar, std::size_t timeSignatureIndex) const;
+
+    double approximateSecondsWithin(const MetricPosition& position,
+                                    std::size_t timeSignatureIndex,
+                                    std::size_t bpmIndex) const noexcept;
+
+    std::size_t findTempoSegment(const Fraction& seconds) const noexcept;
+    std::size_t findTempoSegment(double seconds) const noexcept;
+    std::size_t findTimeSignatureChange(long long beats) const noexcept;
+    std::size_t findTimeSignatureChange(const Fraction& wholeNotes) const noexcept;
+
+    Fraction beatsWithin(const Fraction& seconds, std::size_t bpmIndex) const;
+    MetricPosition positionWithin(const Fraction& beats, std::size_t timeSignatureIndex) const;
+
+    Fraction secondsWithin(const MetricPosition& position,
+                           std::size_t timeSignatureIndex,
+                           std::size_t bpmIndex) const;
+
+    // Sort and deduplicate the assigned changes, and rebuild the prefix sums
+    void updateAssignedTimeSignatureChanges();
+    void updateAssignedBpmChanges();
+
+    // Bring the prefix sums up to date from the change at the index onwards
+    void updateMeterSegmentsFrom(std::size_t index);
+    void updateTempoSegmentsFrom(std::size_t index);
+    void updateTempoSegmentsAfter(BarNumber bar);
+    void updateTempoRamp(std::size_t index);
+
     TimeSignature defaultTimeSignature_;
     TempoBpm defaultBpm_;
     BarNumber initialBar_;
 
-    std::map<BarNumber, TimeSignature, std::greater<BarNumber>> timeSignatureChanges_;
-    std::map<MetricPosition, TempoBpm, std::greater<MetricPosition>> bpmChanges_;
+    std::vector<TimeSignatureChanges::Change> timeSignatureChanges_;
+    std::vector<BpmChanges::Change> bpmChanges_;
+
+    // Parallel to bpmChanges_
+    std::vector<TempoRamp> bpmRamps_;
+
+    // Parallel to timeSignatureChanges_ and bpmChanges_. The beats and whole notes of a time
+    // signature change are those from the first time signature change to its bar.
+    std::vector<MeterSegment> meterSegments_;
+    std::vector<TempoSegment> tempoSegments_;
+    Fraction initialBarWholeNotes_;
+};
+
+
+// Maps increasing timestamps to metric positions by stepping forward through the changes of a
+// metric structure, which makes each call amortized constant time. A timestamp earlier than the
+// previous one is found with a search. The metric structure must outlive the stream and not be
+// modified while it is used.
+class MetricStructure::PositionStream final {
+
+public:
+    MetricPosition positionAt(const Fraction& seconds);
+
+private:
+    friend class MetricStructure;
+
+    explicit PositionStream(const MetricStructure& metricStructure) noexcept;
+
+    const MetricStructure* metricStructure_;
+    std::size_t timeSignatureIndex_ = 0;
+    std::size_t bpmIndex_ = 0;
+    Fraction previousSeconds_;
+};
+
+
+// Answers the queries of a metric structure at a position that mostly moves forward. Moving
+// forward steps through the changes from the current ones, so each move costs amortized constant
+// time; moving back, or far ahead, searches. A cursor never allocates, so it can be used on a
+// real-time thread. The metric structure must outlive the cursor and not be modified while it is
+// used.
+class MetricStructure::Cursor final {
+
+public:
+    void moveTo(const MetricPosition& position) noexcept;
+
+    const MetricPosition& position() const noexcept { return position_; }
+
+    const std::pair<BarNumber, TimeSignature>& lastestTimeSignatureChange() const noexcept;
+
+    const std::pair<MetricPosition, TempoBpm>& lastestBpmChange() const noexcept;
+
+    Fraction seconds() const;
+
+    double approximateSeconds() const noexcept;
+
+private:
+    friend class MetricStructure;
+
+    // How many changes moving forward steps through before it searches instead
+    static constexpr std::size_t maxSteps = 4;
+
+    Cursor(const MetricStructure& metricStructure, const MetricPosition& position) noexcept;
+
+    const MetricStructure* metricStructure_;
+    MetricPosition position_;
+    std::size_t timeSignatureIndex_;
+    std::size_t bpmIndex_;
+};
+
+
+// Steps through beats like a cursor, from one bar to the next along the time signature changes, so
+// that each step costs amortized constant time. The metric structure must outlive the range and
+// its iterators, and not be modified while they are used.
+class MetricStructure::BeatRange final {
+
+public:
+    struct Beat {
+        MetricPosition position;
+        double seconds = 0;
+    };
+
+    class Iterator;
+
+    Iterator begin() const;
+    Iterator end() const;
+
+private:
+    friend class MetricStructure;
+
+    BeatRange(const MetricStructure& metricStructure,
+              const MetricPosition& from,
+              const MetricPosition& to,
+              int subdivision);
+
+    // The first subdivision of a beat at or after the position, as a bar and the subdivisions
+    // before it within the bar
+    std::pair<BarNumber, long long> firstAtOrAfter(const MetricPosition& position) const;
+
+    const MetricStructure* metricStructure_;
+    int subdivision_;
+    std::pair<BarNumber, long long> first_;
+    std::pair<BarNumber, long long> last_;
+};
+
+
+class MetricStructure::BeatRange::Iterator final {
+
+public:
+    using iterator_category = std::forward_iterator_tag;
+    using value_type = Beat;
+    using difference_type = std::ptrdiff_t;
+    using pointer = const Beat*;
+    using reference = const Beat&;
+
+    Iterator() = default;
+
+    const Beat& operator*() const noexcept { return beat_; }
+    const Beat* operator->() const noexcept { return &beat_; }
+
+    Iterator& operator++() noexcept;
+    Iterator operator++(int) noexcept;
+
+    friend bool operator==(const Iterator& left, const Iterator& right) noexcept
+    {
+        return left.bar_ == right.bar_ && left.subdivisionInBar_ == right.subdivisionInBar_;
+    }
+
+    friend bool operator!=(const Iterator& left, const Iterator& right) noexcept
+    {
+        return !(left == right);
+    }
+
+private:
+    friend class BeatRange;
+
+    Iterator(const MetricStructure& metricStructure,
+             int subdivision,
+             std::pair<BarNumber, long long> subdivisionPosition) noexcept;
+
+    void updateBeat() noexcept;
+
+    const MetricStructure* metricStructure_ = nullptr;
+    int subdivision_ = 1;
+    BarNumber bar_ = 0;
+    long long subdivisionInBar_ = 0;
+    std::size_t timeSignatureIndex_ = 0;
+    std::size_t bpmIndex_ = 0;
+    Beat beat_;
+};
+
+
+// Finds the bar lines, beats and BPM changes within consecutive blocks of samples, such as those an
+// audio callback processes. Each event is at the first sample at or after it, taken from its exact
+// seconds, so that no error accumulates over hours of audio; only within a ramp, and after an
+// exponential one, are the seconds approximate. Rendering a block costs a comparison, and a step
+// per event, and never allocates. The metric structure must outlive the renderer and not be
+// modified while it is used.
+class MetricStructure::BlockRenderer final {
+
+public:
+    struct Event {
+        enum class Kind { bar, beat, bpmChange };
+
+        Kind kind;
+        long long sampleOffset;
+        MetricPosition position;
+    };
+
+    // The first sample of the next block
+    long long sample() const noexcept { return sample_; }
+
+    // Writes the events of the next block of numSamples samples to the output, in order, with
+    // their samples offset from the first sample of the block. A BPM change on a beat comes after
+    // it.
+    template <typename OutputIt>
+    OutputIt render(long long numSamples, OutputIt events);
+
+    // Continues from another sample, such as after the playhead jumps
+    void seek(long long sample);
+
+private:
+    friend class MetricStructure;
+
+    BlockRenderer(const MetricStructure& metricStructure, long long sampleRate, long long sample);
+
+    long long sampleAt(const MetricPosition& position,
+                       std::size_t timeSignatureIndex,
+                       std::size_t bpmIndex) const;
+
+    void advanceBeat();
+    void advanceBpmChange();
+
+    const MetricStructure* metricStructure_;
+    long long sampleRate_;
+    long long sample_ = 0;
+
+    // The next beat, its sample and the changes at it
+    MetricPosition beat_;
+    long long beatSample_ = 0;
+    std::size_t timeSignatureIndex_ = 0;
+    std::size_t bpmIndex_ = 0;
+
+    // The next BPM change, and its sample, which is past every other when there is none
+    std::size_t bpmChangeIndex_ = 0;
+    long long bpmChangeSample_ = 0;
 };
 
 
@@ -149,5 +545,116 @@ constexpr bool operator>=(const MetricPosition& left, const MetricPosition& righ
     return !(left < right);
 }
 
+template <typename Key, typename Value>
+constexpr ChangeView<Key, Value>::ChangeView(const Change* const first,
+                                             const std::size_t size) noexcept :
+    first_ {first},
+    size_ {size}
+{
+}
+
+template <typename InputIt>
+void MetricStructure::assignTimeSignatureChanges(InputIt first, const InputIt last)
+{
+    timeSignatureChanges_.assign(1, {initialBar_, defaultTimeSignature_});
+
+    for (; first != last; ++first)
+    {
+        const auto& [bar, timeSignature] = *first;
+        timeSignatureChanges_.emplace_back(bar, timeSignature);
+    }
+
+    updateAssignedTimeSignatureChanges();
+}
+
+template <typename Changes>
+void MetricStructure::assignTimeSignatureChanges(const Changes& changes)
+{
+    assignTimeSignatureChanges(std::begin(changes), std::end(changes));
+}
+
+template <typename InputIt>
+void MetricStructure::assignBpmChanges(InputIt first, const InputIt last)
+{
+    bpmChanges_.assign(1, {initialBar_, defaultBpm_});
+    bpmRamps_.assign(1, TempoRamp::none);
+
+    for (; first != last; ++first)
+    {
+        const auto& change = *first;
+        using Change = std::decay_t<decltype(change)>;
+
+        bpmChanges_.emplace_back(std::get<0>(change), std::get<1>(change));
+
+        if constexpr (std::tuple_size_v<Change> > 2)
+            bpmRamps_.push_back(std::get<2>(change));
+        else
+            bpmRamps_.push_back(TempoRamp::none);
+    }
+
+    updateAssignedBpmChanges();
+}
+
+template <typename Changes>
+void MetricStructure::assignBpmChanges(const Changes& changes)
+{
+    assignBpmChanges(std::begin(changes), std::end(changes));
+}
+
+template <typename OutputIt>
+OutputIt MetricStructure::BlockRenderer::render(const long long numSamples, OutputIt events)
+{
+    const auto end = sample_ + numSamples;
+
+    while (beatSample_ < end || bpmChangeSample_ < end)
+    {
+        const auto isBeatNext =
+            beatSample_ < bpmChangeSample_
+            || (beatSample_ == bpmChangeSample_
+                && !(metricStructure_->bpmChanges_[bpmChangeIndex_].first < beat_));
+
+        if (isBeatNext)
+        {
+            const auto kind = (beat_.beat == 0) ? Event::Kind::bar : Event::Kind::beat;
+            *events++ = Event {kind, beatSample_ - sample_, beat_};
+            advanceBeat();
+        }
+        else
+        {
+            *events++ = Event {Event::Kind::bpmChange,
+                               bpmChangeSample_ - sample_,
+                               metricStructure_->bpmChanges_[bpmChangeIndex_].first};
+            advanceBpmChange();
+        }
+    }
+
+    sample_ = end;
+
+    return events;
+}
+
+template <typename InputIt, typename OutputIt>
+OutputIt MetricStructure::secondsAt(InputIt first, const InputIt last, OutputIt dFirst) const
+{
+    auto timeSignatureIndex = std::size_t(0);
+    auto bpmIndex = std::size_t(0);
+
+    for (; first != last; ++first, ++dFirst)
+    {
+        const MetricPosition& position = *first;
+
+        while (timeSignatureIndex + 1 < timeSignatureChanges_.size()
+               && timeSignatureChanges_[timeSignatureIndex + 1].first <= position.bar)
+            ++timeSignatureIndex;
+
+        while (bpmIndex + 1 < bpmChanges_.size() && bpmChanges_[bpmIndex + 1].first <= position)
+            ++bpmIndex;
+
+        *dFirst = secondsWithin(position, timeSignatureIndex, bpmIndex);
+    }
+
+    return dFirst;
+}
+
 
 }; // namespace Cbb
@@ -2,8 +2,10 @@
 
 #include <Cbb/Fraction.hpp>
 
+#include <array>
 #include <climits>
 #include <cmath>
+#include <iterator>
 #include <vector>
 
 
@@ -101,52 +103,188 @@ constexpr Fraction operator/(const NoteValue& dividend, const NoteValue& divisor
 constexpr Fraction operator%(const NoteValue& dividend, const NoteValue& divisor) noexcept;
 
 
-// Uniformly represents either a single note value or a sequence of tied note values
+// Uniformly represents either a single note value or a sequence of tied note values. Up to
+// inlineCapacity note values are stored in the object itself, so that the common single note
+// values and short ties never allocate; longer ties spill to the heap. The relative value is kept
+// up to date by every modification, so querying and comparing composites is constant time.
 class CompositeNoteValue final {
 
 public:
     enum Type { single, tied };
 
+    class Reference;
+
+    static constexpr std::size_t inlineCapacity = 3;
+
     CompositeNoteValue() = default;
     CompositeNoteValue(NoteValueBase base);
     CompositeNoteValue(const NoteValue& value);
     CompositeNoteValue(std::initializer_list<NoteValue> values);
 
+    CompositeNoteValue(const CompositeNoteValue&) = default;
+    CompositeNoteValue& operator=(const CompositeNoteValue&) = default;
+
+    // Leaves the moved-from composite a single whole note
+    CompositeNoteValue(CompositeNoteValue&& other) noexcept;
+    CompositeNoteValue& operator=(CompositeNoteValue&& other) noexcept;
+
     CompositeNoteValue& append(const CompositeNoteValue& value);
     CompositeNoteValue& operator+=(const CompositeNoteValue& value);
 
     CompositeNoteValue& prepend(const CompositeNoteValue& value);
 
     const NoteValue& operator[](std::size_t index) const;
-    NoteValue& operator[](std::size_t index);
+    Reference operator[](std::size_t index);
 
-    std::size_t size() const noexcept { return values_.size(); }
+    std::size_t size() const noexcept { return size_; }
 
-    Fraction relativeValue() const noexcept;
+    Fraction relativeValue() const noexcept { return relativeValue_; }
 
     Type type() const noexcept;
 
-    using Iterator = std::vector<NoteValue>::iterator;
-    using ConstIterator = std::vector<NoteValue>::const_iterator;
-    using ReverseIterator = std::vector<NoteValue>::reverse_iterator;
-    using ConstReverseIterator = std::vector<NoteValue>::const_reverse_iterator;
-
-    ConstIterator begin() const noexcept { return values_.begin(); }
-    Iterator begin() noexcept { return values_.begin(); }
-    ConstIterator end() const noexcept { return values_.end(); }
-    Iterator end() noexcept { return values_.end(); }
-    ConstReverseIterator rbegin() const noexcept { return values_.rbegin(); }
-    ReverseIterator rbegin() noexcept { return values_.rbegin(); }
-    ConstReverseIterator rend() const noexcept { return values_.rend(); }
-    ReverseIterator rend() noexcept { return values_.rend(); }
-
-    ConstIterator cbegin() const noexcept { return values_.begin(); }
-    ConstIterator cend() const noexcept { return values_.end(); }
-    ConstReverseIterator crbegin() const noexcept { return values_.rbegin(); }
-    ConstReverseIterator crend() const noexcept { return values_.rend(); }
+    class Iterator;
+    using ConstIterator = const NoteValue*;
+    using ReverseIterator = std::reverse_iterator<Iterator>;
+    using ConstReverseIterator = std::reverse_iterator<ConstIterator>;
+
+    ConstIterator begin() const noexcept { return data(); }
+    Iterator begin() noexcept;
+    ConstIterator end() const noexcept { return data() + size_; }
+    Iterator end() noexcept;
+    ConstReverseIterator rbegin() const noexcept { return ConstReverseIterator(end()); }
+    ReverseIterator rbegin() noexcept;
+    ConstReverseIterator rend() const noexcept { return ConstReverseIterator(begin()); }
+    ReverseIterator rend() noexcept;
+
+    ConstIterator cbegin() const noexcept { return begin(); }
+    ConstIterator cend() const noexcept { return end(); }
+    ConstReverseIterator crbegin() const noexcept { return rbegin(); }
+    ConstReverseIterator crend() const noexcept { return rend(); }
+
+private:
+    // The heap storage is only used, and then for good, once the size exceeds inlineCapacity
+    bool isInline() const noexcept { return heapValues_.empty(); }
+
+    const NoteValue* data() const noexcept;
+    NoteValue* data() noexcept;
+
+    void insert(std::size_t index, const CompositeNoteValue& value);
+    void replace(std::size_t index, const NoteValue& value) noexcept;
+    void reset() noexcept;
+
+    std::array<NoteValue, inlineCapacity> inlineValues_ = {};
+    std::vector<NoteValue> heapValues_;
+    std::size_t size_ = 1;
+    Fraction relativeValue_ = reduce(NoteValue().relativeValue());
+};
+
+// Returned by the mutable CompositeNoteValue::operator[]. Reads as the note value at the index, and
+// assigning to it replaces that note value and adjusts the composite's relative value. Being a
+// value, it does not bind to auto&: read through const NoteValue& or a const composite, and write
+// through auto&&. Swapping two references swaps their note values, so std::sort and std::reverse
+// work on a composite, as does an unqualified swap after using std::swap.
+class CompositeNoteValue::Reference final {
+
+public:
+    Reference& operator=(const NoteValue& value) noexcept;
+    Reference& operator=(const Reference& other) noexcept;
+
+    operator const NoteValue&() const noexcept
+    {
+        return static_cast<const CompositeNoteValue&>(*owner_).data()[index_];
+    }
+
+    NoteValueBase base() const noexcept { return get().base(); }
+    Tuplet tuplet() const noexcept { return get().tuplet(); }
+    std::size_t numDots() const noexcept { return get().numDots(); }
+
+    Fraction relativeValue() const noexcept { return get().relativeValue(); }
+
+    friend void swap(Reference left, Reference right) noexcept;
+
+private:
+    friend class CompositeNoteValue;
+    friend class Iterator;
+
+    Reference(CompositeNoteValue& owner, std::size_t index) noexcept;
+
+    const NoteValue& get() const noexcept { return *this; }
+
+    CompositeNoteValue* owner_;
+    std::size_t index_;
+};
+
+// Random access over a mutable composite note value, dereferencing to Reference so that writes
+// through it keep the relative value in step
+class CompositeNoteValue::Iterator final {
+
+public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type = NoteValue;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = Reference;
+
+    Iterator() noexcept = default;
+
+    Reference operator*() const noexcept { return Reference(*owner_, index_); }
+    Reference operator[](difference_type n) const noexcept { return *(*this + n); }
+
+    Iterator& operator++() noexcept;
+    Iterator operator++(int) noexcept;
+    Iterator& operator--() noexcept;
+    Iterator operator--(int) noexcept;
+
+    Iterator& operator+=(difference_type n) noexcept;
+    Iterator& operator-=(difference_type n) noexcept;
+
+    friend Iterator operator+(Iterator it, difference_type n) noexcept { return it += n; }
+    friend Iterator operator+(difference_type n, Iterator it) noexcept { return it += n; }
+    friend Iterator operator-(Iterator it, difference_type n) noexcept { return it -= n; }
+
+    friend difference_type operator-(const Iterator& left, const Iterator& right) noexcept
+    {
+        return static_cast<difference_type>(left.index_)
+               - static_cast<difference_type>(right.index_);
+    }
+
+    friend bool operator==(const Iterator& left, const Iterator& right) noexcept
+    {
+        return left.owner_ == right.owner_ && left.index_ == right.index_;
+    }
+
+    friend bool operator!=(const Iterator& left, const Iterator& right) noexcept
+    {
+        return !(left == right);
+    }
+
+    friend bool operator<(const Iterator& left, const Iterator& right) noexcept
+    {
+        return left.index_ < right.index_;
+    }
+
+    friend bool operator<=(const Iterator& left, const Iterator& right) noexcept
+    {
+        return !(right < left);
+    }
+
+    friend bool operator>(const Iterator& left, const Iterator& right) noexcept
+    {
+        return right < left;
+    }
+
+    friend bool operator>=(const Iterator& left, const Iterator& right) noexcept
+    {
+        return !(left < right);
+    }
 
 private:
-    std::vector<NoteValue> values_ = {wholeNote};
+    friend class CompositeNoteValue;
+
+    Iterator(CompositeNoteValue& owner, std::size_t index) noexcept;
+
+    CompositeNoteValue* owner_ = nullptr;
+    std::size_t index_ = 0;
 };
 
 Fraction relativeValue(const CompositeNoteValue& value) noexcept;
@@ -0,0 +1,138 @@
+#pragma once
+
+#include <Cbb/Metre.hpp>
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+
+namespace Cbb {
+
+
+// Shares a metric structure between editing threads and real-time reader threads, RCU style. An
+// update modifies a copy of the current metric structure and publishes it with one atomic store, so
+// readers only ever see immutable snapshots. Reading a snapshot is wait-free: a reader announces
+// the epoch it started in, loads the current snapshot and clears the announcement when done. A
+// replaced snapshot is freed by a later update once no reader that started before it was replaced
+// is still reading.
+class SharedMetricStructure final {
+
+public:
+    static constexpr std::size_t maxNumReaders = 64;
+
+    class Reader;
+    class Snapshot;
+
+    explicit SharedMetricStructure(MetricStructure metricStructure);
+
+    SharedMetricStructure(const SharedMetricStructure&) = delete;
+    SharedMetricStructure& operator=(const SharedMetricStructure&) = delete;
+
+    // Every reader and snapshot must have been destroyed
+    ~SharedMetricStructure();
+
+    // Registers a reader, e.g. for the audio thread. Registering is not wait-free, so it is best
+    // done before reading starts. Throws std::length_error if maxNumReaders readers are
+    // registered.
+    Reader reader();
+
+    // Calls modify with a copy of the current metric structure and publishes the modified copy.
+    // Updates are serialized by a mutex, which readers never take.
+    template <typename Modify>
+    void update(Modify&& modify);
+
+    void publish(MetricStructure metricStructure);
+
+    // Frees the replaced snapshots that no reader can still be reading and returns how many
+    // remain. Every update reclaims, so this is only needed to free memory without updating.
+    std::size_t reclaim();
+
+private:
+    struct RetiredSnapshot {
+        std::unique_ptr<const MetricStructure> metricStructure;
+        std::uint64_t epoch;
+    };
+
+    void publishLocked(MetricStructure metricStructure);
+    std::size_t reclaimLocked();
+
+    // A reader's epoch is 0 while it is not reading
+    std::atomic<const MetricStructure*> current_;
+    std::atomic<std::uint64_t> epoch_ {1};
+    std::array<std::atomic<std::uint64_t>, maxNumReaders> readerEpochs_ = {};
+    std::array<std::atomic<bool>, maxNumReaders> isReaderRegistered_ = {};
+
+    std::mutex updateMutex_;
+    std::vector<RetiredSnapshot> retired_;
+};
+
+// A registered reader. A reader holds at most one snapshot at a time, so each real-time thread
+// should have its own.
+class SharedMetricStructure::Reader final {
+
+public:
+    Reader(Reader&& other) noexcept;
+    Reader& operator=(Reader&& other) noexcept;
+
+    ~Reader();
+
+    // Wait-free. The previous snapshot of this reader must have been destroyed, or be assigned the
+    // one read, as in snapshot = reader.read().
+    Snapshot read() noexcept;
+
+private:
+    friend class SharedMetricStructure;
+
+    Reader(SharedMetricStructure& shared, std::size_t index) noexcept;
+
+    SharedMetricStructure* shared_;
+    std::size_t index_;
+};
+
+// The metric structure as it was when read. Its destruction lets the snapshot be freed once it has
+// been replaced.
+class SharedMetricStructure::Snapshot final {
+
+public:
+    Snapshot(Snapshot&& other) noexcept;
+    Snapshot& operator=(Snapshot&& other) noexcept;
+
+    ~Snapshot();
+
+    const MetricStructure& operator*() const noexcept { return *metricStructure_; }
+    const MetricStructure* operator->() const noexcept { return metricStructure_; }
+
+private:
+    friend class Reader;
+
+    Snapshot(std::atomic<std::uint64_t>& readerEpoch,
+             const MetricStructure& metricStructure) noexcept;
+
+    std::atomic<std::uint64_t>* readerEpoch_;
+    const MetricStructure* metricStructure_;
+};
+
+
+// =================================================================================================
+
+
+template <typename Modify>
+void SharedMetricStructure::update(Modify&& modify)
+{
+    // Locked before loading, so that no other update replaces and frees the metric structure while
+    // it is copied, or publishes an edit that this one would then overwrite
+    const auto lock = std::lock_guard<std::mutex>(updateMutex_);
+
+    auto metricStructure = MetricStructure(*current_.load());
+    std::forward<Modify>(modify)(metricStructure);
+
+    publishLocked(std::move(metricStructure));
+}
+
+
+}; // namespace Cbb
@@ -0,0 +1,196 @@
+#pragma once
+
+#include <Cbb/Fraction.hpp>
+#include <Cbb/NoteValue.hpp>
+
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+
+namespace Cbb {
+
+
+// A fixed number of integer ticks per whole. Once a set of onsets or durations has been projected
+// into a domain in which each is a whole number of ticks, comparing, hashing and summing them are
+// single integer operations.
+class TickDomain final {
+
+public:
+    constexpr TickDomain() noexcept = default;
+    explicit constexpr TickDomain(long long resolution);
+
+    constexpr long long resolution() const noexcept { return resolution_; }
+
+    // Throws std::invalid_argument if the fraction is undefined or not a whole number of ticks, and
+    // std::overflow_error if the ticks do not fit in a long long
+    constexpr long long toTicks(const Fraction& fraction) const;
+
+    // The ticks as a reduced fraction with a positive denominator
+    constexpr Fraction toFraction(long long ticks) const noexcept;
+
+    template <typename InputIt, typename OutputIt>
+    constexpr OutputIt toTicks(InputIt first, InputIt last, OutputIt destination) const;
+
+    template <typename InputIt, typename OutputIt>
+    constexpr OutputIt toFractions(InputIt first, InputIt last, OutputIt destination) const;
+
+private:
+    long long resolution_ = 1;
+};
+
+constexpr bool operator==(const TickDomain& left, const TickDomain& right) noexcept;
+constexpr bool operator!=(const TickDomain& left, const TickDomain& right) noexcept;
+
+// The coarsest domain in which the ticks of both domains are whole numbers of ticks. Throws
+// std::overflow_error if its resolution does not fit in a long long.
+constexpr TickDomain commonTickDomain(const TickDomain& left, const TickDomain& right);
+
+// The coarsest domain in which every fraction is a whole number of ticks, whose resolution is the
+// least common multiple of the reduced denominators. Throws std::invalid_argument for an undefined
+// fraction and std::overflow_error if the resolution does not fit in a long long.
+template <typename InputIt>
+constexpr TickDomain commonTickDomain(InputIt first, InputIt last);
+
+// The coarsest domain in which the relative value of every note value is a whole number of ticks
+template <typename InputIt>
+constexpr TickDomain noteValueTickDomain(InputIt first, InputIt last);
+
+
+namespace detail {
+
+constexpr long long checkedTickProduct(const long long left, const long long right)
+{
+    constexpr auto max = std::numeric_limits<long long>::max();
+
+    const auto leftMagnitude = (left < 0) ? -left : left;
+    const auto rightMagnitude = (right < 0) ? -right : right;
+
+    if (rightMagnitude != 0 && leftMagnitude > max / rightMagnitude)
+        throw std::overflow_error("the ticks do not fit in a long long");
+
+    return left * right;
+}
+
+constexpr long long positiveReducedDenominator(const Fraction& fraction)
+{
+    if (isUndefined(fraction))
+        throw std::invalid_argument("an undefined fraction has no ticks");
+
+    const auto denominator = reduce(fraction).denominator();
+
+    return (denominator < 0) ? -denominator : denominator;
+}
+
+// Built from the reduced tuplet factor and dot augmentation so that only the base can grow it
+constexpr long long relativeValueDenominator(const NoteValue& noteValue)
+{
+    const auto factor = reduce(calculateTupletFactor(noteValue.tuplet())
+                               * calculateDotAugmentation(noteValue.numDots()));
+    const auto exponent = static_cast<int>(noteValue.base());
+
+    const auto denominator = positiveReducedDenominator(factor);
+
+    if (exponent >= 0)
+        return denominator / std::gcd(denominator, 1LL << exponent);
+
+    const auto scale = 1LL << -exponent;
+
+    return checkedTickProduct(denominator, scale / std::gcd(factor.numerator(), scale));
+}
+
+} // namespace detail
+
+
+constexpr TickDomain::TickDomain(const long long resolution) : resolution_ {resolution}
+{
+    if (resolution <= 0)
+        throw std::invalid_argument("a tick resolution must be positive");
+}
+
+constexpr long long TickDomain::toTicks(const Fraction& fraction) const
+{
+    if (isUndefined(fraction))
+        throw std::invalid_argument("an undefined fraction has no ticks");
+
+    const auto reduced = reduce(fraction);
+    const auto sign = (reduced.denominator() < 0) ? -1 : 1;
+
+    if (resolution_ % reduced.denominator() != 0)
+        throw std::invalid_argument("the fraction is not a whole number of ticks");
+
+    return detail::checkedTickProduct(sign * reduced.numerator(),
+                                      resolution_ / (sign * reduced.denominator()));
+}
+
+constexpr Fraction TickDomain::toFraction(const long long ticks) const noexcept
+{
+    const auto gcd = std::gcd(ticks, resolution_);
+
+    return {ticks / gcd, resolution_ / gcd};
+}
+
+template <typename InputIt, typename OutputIt>
+constexpr OutputIt TickDomain::toTicks(InputIt first,
+                                       const InputIt last,
+                                       OutputIt destination) const
+{
+    for (; first != last; ++first, ++destination)
+        *destination = toTicks(*first);
+
+    return destination;
+}
+
+template <typename InputIt, typename OutputIt>
+constexpr OutputIt TickDomain::toFractions(InputIt first,
+                                           const InputIt last,
+                                           OutputIt destination) const
+{
+    for (; first != last; ++first, ++destination)
+        *destination = toFraction(*first);
+
+    return destination;
+}
+
+constexpr bool operator==(const TickDomain& left, const TickDomain& right) noexcept
+{
+    return left.resolution() == right.resolution();
+}
+
+constexpr bool operator!=(const TickDomain& left, const TickDomain& right) noexcept
+{
+    return !(left == right);
+}
+
+constexpr TickDomain commonTickDomain(const TickDomain& left, const TickDomain& right)
+{
+    const auto gcd = std::gcd(left.resolution(), right.resolution());
+
+    return TickDomain(detail::checkedTickProduct(left.resolution() / gcd, right.resolution()));
+}
+
+template <typename InputIt>
+constexpr TickDomain commonTickDomain(InputIt first, const InputIt last)
+{
+    auto result = TickDomain();
+
+    for (; first != last; ++first)
+        result = commonTickDomain(result,
+                                  TickDomain(detail::positiveReducedDenominator(*first)));
+
+    return result;
+}
+
+template <typename InputIt>
+constexpr TickDomain noteValueTickDomain(InputIt first, const InputIt last)
+{
+    auto result = TickDomain();
+
+    for (; first != last; ++first)
+        result = commonTickDomain(result, TickDomain(detail::relativeValueDenominator(*first)));
+
+    return result;
+}
+
+
+}; // namespace Cbb
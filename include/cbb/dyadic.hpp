@@ -0,0 +1,385 @@
+#ifndef CBB_DYADIC_HPP
+#define CBB_DYADIC_HPP
+
+#include <cbb/note_value.hpp>
+
+#include <limits>
+#include <stdexcept>
+
+
+namespace cbb {
+
+
+// An odd mantissa times a power of 2, which represents any duration without a
+// tuplet exactly. Multiplying or dividing by a power_of_2 only adds to the
+// exponent, and sums and comparisons align the mantissas with shifts instead
+// of going through a common denominator and its gcd.
+class dyadic final {
+
+public:
+  constexpr dyadic() noexcept = default;
+
+  explicit constexpr dyadic(fraction_rep_t mantissa,
+                            power_of_2 scale = power_of_2()) noexcept;
+
+  constexpr dyadic(power_of_2 p) noexcept;
+
+  // Throws std::invalid_argument if the reduced denominator is not a power of 2
+  explicit constexpr dyadic(fraction const& value);
+
+  constexpr fraction_rep_t get_mantissa() const noexcept { return mantissa_; }
+
+  constexpr power_of_2 get_power_of_2() const noexcept;
+
+  // Throws std::overflow_error if a term of the fraction would not fit in
+  // fraction_rep_t
+  constexpr fraction get_value() const;
+
+  explicit constexpr operator fraction() const { return get_value(); }
+
+private:
+  // Throws std::overflow_error if the normalized mantissa does not fit
+  static constexpr dyadic normalized(long long mantissa, long long exponent);
+
+  friend constexpr int compare(dyadic l, dyadic r) noexcept;
+
+  friend constexpr bool operator==(dyadic l, dyadic r) noexcept;
+
+  friend constexpr dyadic operator-(dyadic d) noexcept;
+
+  friend constexpr dyadic operator+(dyadic l, dyadic r);
+  friend constexpr dyadic operator*(dyadic l, dyadic r);
+  friend constexpr dyadic operator*(dyadic l, power_of_2 r) noexcept;
+  friend constexpr dyadic operator/(dyadic l, power_of_2 r) noexcept;
+
+  // Odd, or zero with a zero exponent, so that equal values are identical
+  fraction_rep_t mantissa_ = 0;
+  int exponent_ = 0;
+};
+
+// Three-way comparison that cannot overflow: negative if l is lesser, zero if
+// equal, positive if l is greater
+constexpr int compare(dyadic l, dyadic r) noexcept;
+
+constexpr bool operator==(dyadic l, dyadic r) noexcept;
+constexpr bool operator!=(dyadic l, dyadic r) noexcept;
+constexpr bool operator<(dyadic l, dyadic r) noexcept;
+constexpr bool operator<=(dyadic l, dyadic r) noexcept;
+constexpr bool operator>(dyadic l, dyadic r) noexcept;
+constexpr bool operator>=(dyadic l, dyadic r) noexcept;
+
+constexpr dyadic operator+(dyadic d) noexcept;
+constexpr dyadic operator-(dyadic d) noexcept;
+
+// Sums and products are exact, and throw std::overflow_error if the mantissa
+// of the result does not fit in fraction_rep_t
+constexpr dyadic operator+(dyadic l, dyadic r);
+constexpr dyadic operator-(dyadic l, dyadic r);
+constexpr dyadic operator*(dyadic l, dyadic r);
+
+constexpr dyadic operator*(dyadic l, power_of_2 r) noexcept;
+constexpr dyadic operator*(power_of_2 l, dyadic r) noexcept;
+constexpr dyadic operator/(dyadic l, power_of_2 r) noexcept;
+
+constexpr dyadic& operator+=(dyadic& l, dyadic r);
+constexpr dyadic& operator-=(dyadic& l, dyadic r);
+constexpr dyadic& operator*=(dyadic& l, dyadic r);
+constexpr dyadic& operator*=(dyadic& l, power_of_2 r) noexcept;
+constexpr dyadic& operator/=(dyadic& l, power_of_2 r) noexcept;
+
+// The relative value of a note value as a dyadic. Only note values with a
+// duplet, quadruplet or octuplet have one; any other tuplet throws
+// std::invalid_argument.
+constexpr dyadic dyadic_relative_value(note_value const& nv);
+
+// The duplet note value with the given relative value. Throws
+// std::invalid_argument if there is none, i.e. unless the value is positive
+// and its mantissa is 2^(n + 1) - 1 for n dots.
+constexpr note_value to_note_value(dyadic d);
+
+
+// =============================================================================
+
+
+constexpr dyadic::dyadic(fraction_rep_t const mantissa,
+                         power_of_2 const scale) noexcept
+{
+  if (mantissa != 0)
+  {
+    auto const shift = detail::count_trailing_zeros(mantissa);
+
+    mantissa_ = static_cast<fraction_rep_t>(mantissa / (1LL << shift));
+    exponent_ = scale.get_exponent() + shift;
+  }
+}
+
+constexpr dyadic::dyadic(power_of_2 const p) noexcept : dyadic {1, p}
+{
+}
+
+constexpr dyadic::dyadic(fraction const& value)
+{
+  auto const reduced = binary_reduce(value);
+
+  if (!detail::is_pow2(reduced.denominator()))
+    throw std::invalid_argument("the denominator is not a power of 2");
+
+  *this = dyadic(reduced.numerator(),
+                 power_of_2(power_of_2::from_exponent,
+                            -detail::count_trailing_zeros(
+                              reduced.denominator())));
+}
+
+constexpr power_of_2 dyadic::get_power_of_2() const noexcept
+{
+  return power_of_2(power_of_2::from_exponent, exponent_);
+}
+
+constexpr fraction dyadic::get_value() const
+{
+  constexpr auto digits = std::numeric_limits<fraction_rep_t>::digits;
+  constexpr auto max = std::numeric_limits<fraction_rep_t>::max();
+
+  if (exponent_ >= 0)
+  {
+    if (exponent_ >= digits || mantissa_ > (max >> exponent_)
+        || mantissa_ < -(max >> exponent_))
+      throw std::overflow_error("the dyadic is too large for a fraction");
+
+    return fraction(mantissa_ * (fraction_rep_t(1) << exponent_));
+  }
+
+  if (-exponent_ >= digits)
+    throw std::overflow_error("the dyadic is too small for a fraction");
+
+  return fraction(mantissa_, fraction_rep_t(1) << -exponent_);
+}
+
+constexpr dyadic dyadic::normalized(long long mantissa, long long exponent)
+{
+  static_assert(std::numeric_limits<fraction_rep_t>::digits
+                  <= std::numeric_limits<long long>::digits / 2,
+                "the products of mantissas must fit in a long long");
+
+  auto result = dyadic();
+
+  if (mantissa == 0)
+    return result;
+
+  auto const shift = detail::count_trailing_zeros(mantissa);
+
+  mantissa /= (1LL << shift);
+  exponent += shift;
+
+  if (mantissa > std::numeric_limits<fraction_rep_t>::max()
+      || mantissa < -std::numeric_limits<fraction_rep_t>::max()
+      || exponent > std::numeric_limits<int>::max()
+      || exponent < std::numeric_limits<int>::min())
+    throw std::overflow_error("the mantissa of a dyadic overflowed");
+
+  result.mantissa_ = static_cast<fraction_rep_t>(mantissa);
+  result.exponent_ = static_cast<int>(exponent);
+
+  return result;
+}
+
+constexpr int compare(dyadic const l, dyadic const r) noexcept
+{
+  constexpr auto digits = std::numeric_limits<fraction_rep_t>::digits;
+
+  auto const l_sign = detail::three_way(l.mantissa_, 0);
+  auto const r_sign = detail::three_way(r.mantissa_, 0);
+
+  if (l_sign != r_sign || l_sign == 0)
+    return detail::three_way(l_sign, r_sign);
+
+  auto const shift = static_cast<long long>(l.exponent_) - r.exponent_;
+
+  // Shifting a mantissa past every bit of the other makes it the greater
+  // magnitude, whatever their values
+  if (shift > digits)
+    return l_sign;
+
+  if (shift < -digits)
+    return -l_sign;
+
+  if (shift >= 0)
+    return detail::three_way(l.mantissa_ * (1LL << shift),
+                             static_cast<long long>(r.mantissa_));
+
+  return detail::three_way(static_cast<long long>(l.mantissa_),
+                           r.mantissa_ * (1LL << -shift));
+}
+
+constexpr bool operator==(dyadic const l, dyadic const r) noexcept
+{
+  return l.mantissa_ == r.mantissa_ && l.exponent_ == r.exponent_;
+}
+
+constexpr bool operator!=(dyadic const l, dyadic const r) noexcept
+{
+  return !(l == r);
+}
+
+constexpr bool operator<(dyadic const l, dyadic const r) noexcept
+{
+  return compare(l, r) < 0;
+}
+
+constexpr bool operator<=(dyadic const l, dyadic const r) noexcept
+{
+  return !(l > r);
+}
+
+constexpr bool operator>(dyadic const l, dyadic const r) noexcept
+{
+  return r < l;
+}
+
+constexpr bool operator>=(dyadic const l, dyadic const r) noexcept
+{
+  return !(l < r);
+}
+
+constexpr dyadic operator+(dyadic const d) noexcept
+{
+  return d;
+}
+
+constexpr dyadic operator-(dyadic const d) noexcept
+{
+  // A normalized mantissa is odd, so it is never the minimum of its type
+  auto result = d;
+  result.mantissa_ = -d.mantissa_;
+
+  return result;
+}
+
+constexpr dyadic operator+(dyadic const l, dyadic const r)
+{
+  constexpr auto digits = std::numeric_limits<fraction_rep_t>::digits;
+
+  if (l.mantissa_ == 0)
+    return r;
+
+  if (r.mantissa_ == 0)
+    return l;
+
+  auto const low = (l.exponent_ < r.exponent_) ? l.exponent_ : r.exponent_;
+  auto const l_shift = static_cast<long long>(l.exponent_) - low;
+  auto const r_shift = static_cast<long long>(r.exponent_) - low;
+
+  // The sum of a mantissa shifted past every bit of the other and an odd
+  // mantissa is odd and larger than any mantissa
+  if (l_shift > digits || r_shift > digits)
+    throw std::overflow_error("the mantissa of a dyadic overflowed");
+
+  return dyadic::normalized(l.mantissa_ * (1LL << l_shift)
+                              + r.mantissa_ * (1LL << r_shift),
+                            low);
+}
+
+constexpr dyadic operator-(dyadic const l, dyadic const r)
+{
+  return l + -r;
+}
+
+constexpr dyadic operator*(dyadic const l, dyadic const r)
+{
+  return dyadic::normalized(static_cast<long long>(l.mantissa_) * r.mantissa_,
+                            static_cast<long long>(l.exponent_) + r.exponent_);
+}
+
+constexpr dyadic operator*(dyadic const l, power_of_2 const r) noexcept
+{
+  auto result = l;
+
+  if (l.mantissa_ != 0)
+    result.exponent_ += r.get_exponent();
+
+  return result;
+}
+
+constexpr dyadic operator*(power_of_2 const l, dyadic const r) noexcept
+{
+  return r * l;
+}
+
+constexpr dyadic operator/(dyadic const l, power_of_2 const r) noexcept
+{
+  auto result = l;
+
+  if (l.mantissa_ != 0)
+    result.exponent_ -= r.get_exponent();
+
+  return result;
+}
+
+constexpr dyadic& operator+=(dyadic& l, dyadic const r)
+{
+  return l = l + r;
+}
+
+constexpr dyadic& operator-=(dyadic& l, dyadic const r)
+{
+  return l = l - r;
+}
+
+constexpr dyadic& operator*=(dyadic& l, dyadic const r)
+{
+  return l = l * r;
+}
+
+constexpr dyadic& operator*=(dyadic& l, power_of_2 const r) noexcept
+{
+  return l = l * r;
+}
+
+constexpr dyadic& operator/=(dyadic& l, power_of_2 const r) noexcept
+{
+  return l = l / r;
+}
+
+constexpr dyadic dyadic_relative_value(note_value const& nv)
+{
+  auto const tuplet_count = detail::to_underlying(nv.get_tuplet());
+
+  if (!detail::is_pow2(tuplet_count))
+    throw std::invalid_argument("the tuplet is not a power of 2");
+
+  auto const num_dots = detail::to_underlying(nv.get_num_dots());
+
+  // The tuplet factor is 2/t and the dot augmentation is (2^(n + 1) - 1)/2^n
+  return dyadic((1 << (num_dots + 1)) - 1,
+                power_of_2(power_of_2::from_exponent,
+                           nv.get_power_of_2().get_exponent() + 1
+                             - detail::count_trailing_zeros(tuplet_count)
+                             - num_dots));
+}
+
+constexpr note_value to_note_value(dyadic const d)
+{
+  constexpr auto max_dots = detail::to_underlying(dot_count::triple);
+
+  auto const next_mantissa = static_cast<long long>(d.get_mantissa()) + 1;
+
+  if (next_mantissa <= 1 || !detail::is_pow2(next_mantissa))
+    throw std::invalid_argument("the value is not that of a duplet note value");
+
+  auto const num_dots = detail::count_trailing_zeros(next_mantissa) - 1;
+
+  if (num_dots > max_dots)
+    throw std::invalid_argument("the value needs more dots than a note value "
+                                "can have");
+
+  return note_value(
+    power_of_2(power_of_2::from_exponent,
+               d.get_power_of_2().get_exponent() + num_dots),
+    static_cast<dot_count>(num_dots));
+}
+
+
+} // namespace cbb
+
+
+#endif
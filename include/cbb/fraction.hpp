@@ -3,6 +3,12 @@
 
 #include <ieme/ieme.hpp>
 
+#include <charconv>
+#include <limits>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
 
 namespace cbb {
 
@@ -10,7 +16,326 @@ namespace cbb {
 using fraction_rep_t = int;
 using fraction_ops_t = ieme::ops::defaults;
 
-using fraction = ieme::fraction<fraction_rep_t, fraction_ops_t>;
+template <typename Rep>
+using basic_fraction = ieme::fraction<Rep, fraction_ops_t>;
+
+using fraction = basic_fraction<fraction_rep_t>;
+
+
+// Three-way comparison of the values of two fractions that cannot overflow:
+// negative if l is lesser, zero if equivalent, positive if l is greater
+template <typename Rep, typename Ops>
+constexpr int compare(ieme::fraction<Rep, Ops> const& l,
+                      ieme::fraction<Rep, Ops> const& r) noexcept;
+
+// Greatest common divisor by Stein's binary algorithm, which replaces the
+// divisions of std::gcd with shifts
+template <typename Rep>
+constexpr Rep binary_gcd(Rep a, Rep b) noexcept;
+
+// Equivalent to reduce, but built on binary_gcd. The denominator of the result
+// is positive.
+template <typename Rep, typename Ops>
+constexpr ieme::fraction<Rep, Ops>
+binary_reduce(ieme::fraction<Rep, Ops> const& f) noexcept;
+
+// Strict weak ordering for sorted containers and algorithms built on compare
+struct fraction_less {
+  template <typename Rep, typename Ops>
+  constexpr bool operator()(ieme::fraction<Rep, Ops> const& l,
+                            ieme::fraction<Rep, Ops> const& r) const noexcept
+  {
+    return compare(l, r) < 0;
+  }
+};
+
+// Parses "n/d" or an integer "n" from the start of the text, without
+// allocating or skipping whitespace. As with std::from_chars, ptr points past
+// the parsed characters, and ec is std::errc::invalid_argument if there is no
+// fraction or the denominator is zero, or std::errc::result_out_of_range if a
+// term does not fit in Rep. f is only assigned on success.
+template <typename Rep, typename Ops>
+std::from_chars_result from_chars(char const* first,
+                                  char const* last,
+                                  ieme::fraction<Rep, Ops>& f) noexcept;
+
+template <typename Rep, typename Ops>
+std::from_chars_result from_chars(std::string_view text,
+                                  ieme::fraction<Rep, Ops>& f) noexcept;
+
+// Writes "n/d", with ec std::errc::value_too_large if it does not fit
+template <typename Rep, typename Ops>
+std::to_chars_result
+to_chars(char* first, char* last, ieme::fraction<Rep, Ops> const& f) noexcept;
+
+
+// =============================================================================
+
+
+namespace detail {
+
+template <typename Rep>
+constexpr int three_way(Rep const l, Rep const r) noexcept
+{
+  return (l < r) ? -1 : (l > r) ? 1 : 0;
+}
+
+template <typename Rep>
+constexpr int count_trailing_zeros(Rep const value) noexcept
+{
+#if defined(__GNUC__)
+  if constexpr (sizeof(Rep) <= sizeof(unsigned long long))
+    return __builtin_ctzll(static_cast<unsigned long long>(value));
+  else
+#endif
+  {
+    auto result = 0;
+
+    for (auto remaining = value; (remaining & Rep(1)) == 0; remaining >>= 1)
+      ++result;
+
+    return result;
+  }
+}
+
+template <typename Rep>
+constexpr bool is_pow2(Rep const value) noexcept
+{
+  return value > 0 && (value & (value - 1)) == 0;
+}
+
+// A signed type at least twice as wide as Rep, or void if there is none
+template <typename Rep>
+using widened_t = std::conditional_t<
+  (sizeof(Rep) * 2 <= sizeof(long long)),
+  long long,
+#if defined(__SIZEOF_INT128__)
+  std::conditional_t<(sizeof(Rep) * 2 <= sizeof(__int128)), __int128, void>
+#else
+  void
+#endif
+  >;
+
+// Both denominators must be positive
+template <typename Rep>
+constexpr int compare_with_pow2_denominators(Rep const l_num,
+                                             Rep const l_den,
+                                             Rep const r_num,
+                                             Rep const r_den) noexcept
+{
+  auto const compare_scaled = [](Rep const num,
+                                 int const shift,
+                                 Rep const other) {
+    auto const limit = std::numeric_limits<Rep>::max() >> shift;
+
+    if (num > limit)
+      return 1;
+
+    if (num < -limit)
+      return -1;
+
+    return three_way(static_cast<Rep>(num * (Rep(1) << shift)), other);
+  };
+
+  auto const l_shift = count_trailing_zeros(l_den);
+  auto const r_shift = count_trailing_zeros(r_den);
+
+  if (l_shift <= r_shift)
+    return compare_scaled(l_num, r_shift - l_shift, r_num);
+
+  return -compare_scaled(r_num, l_shift - r_shift, l_num);
+}
+
+// Both denominators must be positive. Walks the continued fraction expansions
+// so that no intermediate value exceeds the magnitude of the inputs.
+template <typename Rep>
+constexpr int compare_by_continued_fraction(Rep const l_num,
+                                            Rep const l_den,
+                                            Rep const r_num,
+                                            Rep const r_den) noexcept
+{
+  auto const l_sign = three_way(l_num, Rep(0));
+  auto const r_sign = three_way(r_num, Rep(0));
+
+  if (l_sign != r_sign || l_sign == 0)
+    return three_way(l_sign, r_sign);
+
+  auto a = (l_sign > 0) ? l_num : -l_num;
+  auto b = l_den;
+  auto c = (r_sign > 0) ? r_num : -r_num;
+  auto d = r_den;
+  auto orientation = l_sign;
+
+  while (true)
+  {
+    auto const l_quotient = a / b;
+    auto const r_quotient = c / d;
+
+    if (l_quotient != r_quotient)
+      return orientation * three_way(l_quotient, r_quotient);
+
+    auto const l_remainder = a % b;
+    auto const r_remainder = c % d;
+
+    if (l_remainder == 0 || r_remainder == 0)
+      return orientation * three_way(l_remainder, r_remainder);
+
+    // With a/b = q + r/b and c/d = q + r'/d, a/b < c/d exactly when b/r > d/r'
+    a = b;
+    b = l_remainder;
+    c = d;
+    d = r_remainder;
+    orientation = -orientation;
+  }
+}
+
+} // namespace detail
+
+template <typename Rep>
+constexpr Rep binary_gcd(Rep const a, Rep const b) noexcept
+{
+  using unsigned_t = std::make_unsigned_t<Rep>;
+
+  auto const magnitude = [](Rep const value) {
+    return (value < 0) ? unsigned_t(0) - static_cast<unsigned_t>(value)
+                       : static_cast<unsigned_t>(value);
+  };
+
+  auto u = magnitude(a);
+  auto v = magnitude(b);
+
+  if (u == 0)
+    return static_cast<Rep>(v);
+
+  if (v == 0)
+    return static_cast<Rep>(u);
+
+  auto const common_shift = detail::count_trailing_zeros(unsigned_t(u | v));
+
+  u >>= detail::count_trailing_zeros(u);
+  v >>= detail::count_trailing_zeros(v);
+
+  // A power of two operand leaves 1 here, which is the common case for
+  // durations
+  while (u != v && u != 1 && v != 1)
+  {
+    if (u > v)
+    {
+      auto const smaller = v;
+      v = u;
+      u = smaller;
+    }
+
+    v -= u;
+    v >>= detail::count_trailing_zeros(v);
+  }
+
+  u = (u < v) ? u : v;
+
+  return static_cast<Rep>(u << common_shift);
+}
+
+template <typename Rep, typename Ops>
+constexpr ieme::fraction<Rep, Ops>
+binary_reduce(ieme::fraction<Rep, Ops> const& f) noexcept
+{
+  auto const gcd = binary_gcd(f.numerator(), f.denominator());
+
+  if (gcd == 0)
+    return f;
+
+  auto const sign = (f.denominator() < 0) ? Rep(-1) : Rep(1);
+
+  return {static_cast<Rep>(sign * (f.numerator() / gcd)),
+          static_cast<Rep>(sign * (f.denominator() / gcd))};
+}
+
+template <typename Rep, typename Ops>
+constexpr int compare(ieme::fraction<Rep, Ops> const& l,
+                      ieme::fraction<Rep, Ops> const& r) noexcept
+{
+  auto const l_negated = l.denominator() < 0;
+  auto const r_negated = r.denominator() < 0;
+
+  auto const l_num = l_negated ? -l.numerator() : l.numerator();
+  auto const l_den = l_negated ? -l.denominator() : l.denominator();
+  auto const r_num = r_negated ? -r.numerator() : r.numerator();
+  auto const r_den = r_negated ? -r.denominator() : r.denominator();
+
+  if (l_den == r_den)
+    return detail::three_way(l_num, r_num);
+
+  if (detail::is_pow2(l_den) && detail::is_pow2(r_den))
+    return detail::compare_with_pow2_denominators(l_num, l_den, r_num, r_den);
+
+  using wide_t = detail::widened_t<Rep>;
+
+  if constexpr (!std::is_void_v<wide_t>)
+    return detail::three_way(static_cast<wide_t>(l_num) * r_den,
+                             static_cast<wide_t>(r_num) * l_den);
+  else
+    return detail::compare_by_continued_fraction(l_num, l_den, r_num, r_den);
+}
+
+template <typename Rep, typename Ops>
+std::from_chars_result from_chars(char const* const first,
+                                  char const* const last,
+                                  ieme::fraction<Rep, Ops>& f) noexcept
+{
+  auto num = Rep(0);
+
+  auto const num_result = std::from_chars(first, last, num);
+
+  if (num_result.ec != std::errc())
+    return num_result;
+
+  if (num_result.ptr == last || *num_result.ptr != '/')
+  {
+    f = ieme::fraction<Rep, Ops>(num, Rep(1));
+    return num_result;
+  }
+
+  auto den = Rep(1);
+
+  auto const den_result = std::from_chars(num_result.ptr + 1, last, den);
+
+  auto const zero_den = den_result.ec == std::errc() && den == 0;
+
+  if (den_result.ec == std::errc::invalid_argument || zero_den)
+    return {first, std::errc::invalid_argument};
+
+  if (den_result.ec != std::errc())
+    return den_result;
+
+  f = ieme::fraction<Rep, Ops>(num, den);
+
+  return den_result;
+}
+
+template <typename Rep, typename Ops>
+std::from_chars_result from_chars(std::string_view const text,
+                                  ieme::fraction<Rep, Ops>& f) noexcept
+{
+  return cbb::from_chars(text.data(), text.data() + text.size(), f);
+}
+
+template <typename Rep, typename Ops>
+std::to_chars_result to_chars(char* const first,
+                              char* const last,
+                              ieme::fraction<Rep, Ops> const& f) noexcept
+{
+  auto const num_result = std::to_chars(first, last, f.numerator());
+
+  if (num_result.ec != std::errc())
+    return num_result;
+
+  if (num_result.ptr == last)
+    return {last, std::errc::value_too_large};
+
+  *num_result.ptr = '/';
+
+  return std::to_chars(num_result.ptr + 1, last, f.denominator());
+}
 
 
 } // namespace cbb
@@ -3,6 +3,10 @@
 
 #include <cbb/power_of_2_constants.hpp>
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
 #include <type_traits>
 
 
@@ -21,7 +25,8 @@ enum class tuplet {
   decuplet,
 };
 
-constexpr fraction tuplet_factor(tuplet t) noexcept;
+template <typename Rep = fraction_rep_t>
+constexpr basic_fraction<Rep> tuplet_factor(tuplet t) noexcept;
 
 
 enum class dot_count {
@@ -31,54 +36,96 @@ enum class dot_count {
   triple,
 };
 
-constexpr fraction dot_augmentation(dot_count num_dots) noexcept;
+template <typename Rep = fraction_rep_t>
+constexpr basic_fraction<Rep> dot_augmentation(dot_count num_dots) noexcept;
 
 
-class note_value final {
+template <typename Rep>
+class basic_note_value final {
 
 public:
-  constexpr note_value() noexcept = default;
+  using rep_type = Rep;
+  using power_of_2_type = basic_power_of_2<Rep>;
 
-  constexpr explicit note_value(power_of_2 _power_of_2,
-                                tuplet _tuplet = tuplet::duplet,
-                                dot_count num_dots = dot_count::none) noexcept;
+  constexpr basic_note_value() noexcept = default;
 
-  constexpr note_value(power_of_2 _power_of_2, dot_count num_dots) noexcept;
+  constexpr explicit basic_note_value(
+    power_of_2_type _power_of_2,
+    tuplet _tuplet = tuplet::duplet,
+    dot_count num_dots = dot_count::none) noexcept;
 
-  constexpr note_value with(power_of_2 new_power_of_2) const noexcept;
+  constexpr basic_note_value(power_of_2_type _power_of_2,
+                             dot_count num_dots) noexcept;
 
-  constexpr note_value with(tuplet new_tuplet) const noexcept;
+  constexpr basic_note_value
+  with(power_of_2_type new_power_of_2) const noexcept;
 
-  constexpr note_value with(dot_count new_num_dots) const noexcept;
+  constexpr basic_note_value with(tuplet new_tuplet) const noexcept;
 
-  constexpr power_of_2 get_power_of_2() const noexcept { return power_of_2_; }
+  constexpr basic_note_value with(dot_count new_num_dots) const noexcept;
+
+  constexpr power_of_2_type get_power_of_2() const noexcept
+  {
+    return power_of_2_;
+  }
 
   constexpr tuplet get_tuplet() const noexcept { return tuplet_; }
 
   constexpr dot_count get_num_dots() const noexcept { return num_dots_; }
 
 private:
-  power_of_2 power_of_2_ = numbers::_1;
+  power_of_2_type power_of_2_ = numbers::_1_v<Rep>;
   tuplet tuplet_ = tuplet::duplet;
   dot_count num_dots_ = dot_count::none;
 };
 
-constexpr fraction relative_value(note_value const& nv) noexcept;
-
-constexpr bool operator==(note_value const& l, note_value const& r) noexcept;
-constexpr bool operator!=(note_value const& l, note_value const& r) noexcept;
-constexpr bool operator<(note_value const& l, note_value const& r) noexcept;
-constexpr bool operator<=(note_value const& l, note_value const& r) noexcept;
-constexpr bool operator>(note_value const& l, note_value const& r) noexcept;
-constexpr bool operator>=(note_value const& l, note_value const& r) noexcept;
-
-constexpr note_value operator*(note_value const& l, power_of_2 r) noexcept;
-constexpr note_value operator*(power_of_2 l, note_value const& r) noexcept;
-
-constexpr fraction operator/(note_value const& l, note_value const& r) noexcept;
-constexpr note_value operator/(note_value const& l, power_of_2 r) noexcept;
-
-constexpr fraction operator%(note_value const& l, note_value const& r) noexcept;
+using note_value = basic_note_value<fraction_rep_t>;
+
+// Throws std::overflow_error if a term of the relative value does not fit in
+// Rep, as do the comparisons and quotients below that need it
+template <typename Rep>
+constexpr basic_fraction<Rep>
+relative_value(basic_note_value<Rep> const& nv);
+
+template <typename Rep>
+constexpr bool operator==(basic_note_value<Rep> const& l,
+                          basic_note_value<Rep> const& r);
+template <typename Rep>
+constexpr bool operator!=(basic_note_value<Rep> const& l,
+                          basic_note_value<Rep> const& r);
+template <typename Rep>
+constexpr bool operator<(basic_note_value<Rep> const& l,
+                         basic_note_value<Rep> const& r);
+template <typename Rep>
+constexpr bool operator<=(basic_note_value<Rep> const& l,
+                          basic_note_value<Rep> const& r);
+template <typename Rep>
+constexpr bool operator>(basic_note_value<Rep> const& l,
+                         basic_note_value<Rep> const& r);
+template <typename Rep>
+constexpr bool operator>=(basic_note_value<Rep> const& l,
+                          basic_note_value<Rep> const& r);
+
+template <typename Rep>
+constexpr basic_note_value<Rep> operator*(basic_note_value<Rep> const& l,
+                                          basic_power_of_2<Rep> r) noexcept;
+template <typename Rep>
+constexpr basic_note_value<Rep>
+operator*(basic_power_of_2<Rep> l,
+          basic_note_value<Rep> const& r) noexcept;
+
+template <typename Rep>
+constexpr basic_fraction<Rep>
+operator/(basic_note_value<Rep> const& l,
+          basic_note_value<Rep> const& r);
+template <typename Rep>
+constexpr basic_note_value<Rep> operator/(basic_note_value<Rep> const& l,
+                                          basic_power_of_2<Rep> r) noexcept;
+
+template <typename Rep>
+constexpr basic_fraction<Rep>
+operator%(basic_note_value<Rep> const& l,
+          basic_note_value<Rep> const& r);
 
 
 // =============================================================================
@@ -90,107 +137,339 @@ constexpr std::underlying_type_t<EnumT> to_underlying(EnumT const e)
 {
   return static_cast<std::underlying_type_t<EnumT>>(e);
 }
+
+// The reduced relative values of the note values scores actually use, and
+// their ranks in ascending order of relative value, with equal relative values
+// sharing a rank. Comparing two of these note values compares their ranks.
+struct relative_value_table {
+  static constexpr int min_exponent = -12;
+  static constexpr int max_exponent = 4;
+  static constexpr std::size_t num_tuplets = 9;
+  static constexpr std::size_t num_dot_counts = 4;
+  static constexpr std::size_t size = (max_exponent - min_exponent + 1)
+                                      * num_tuplets * num_dot_counts;
+
+  // The index of a note value, or size if the table does not have it
+  template <typename Rep>
+  static constexpr std::size_t
+  index_of(basic_note_value<Rep> const& nv) noexcept
+  {
+    auto const exponent = nv.get_power_of_2().get_exponent();
+
+    if (exponent < min_exponent || exponent > max_exponent)
+      return size;
+
+    return index_of(exponent, nv.get_tuplet(), nv.get_num_dots());
+  }
+
+  static constexpr std::size_t index_of(int const exponent,
+                                        tuplet const t,
+                                        dot_count const num_dots) noexcept
+  {
+    return (static_cast<std::size_t>(exponent - min_exponent) * num_tuplets
+            + static_cast<std::size_t>(to_underlying(t) - 2))
+             * num_dot_counts
+           + static_cast<std::size_t>(to_underlying(num_dots));
+  }
+
+  std::array<fraction_rep_t, size> numerators {};
+  std::array<fraction_rep_t, size> denominators {};
+  std::array<std::uint16_t, size> ranks {};
+};
+
+constexpr relative_value_table make_relative_value_table() noexcept
+{
+  using table_t = relative_value_table;
+
+  // Scaled by 2520, the least common multiple of the tuplet counts, and by
+  // 2^16, every relative value in the table is an exact integer key
+  constexpr auto scale = std::int64_t(2520) << 16;
+
+  auto table = table_t();
+  auto keys = std::array<std::int64_t, table_t::size>();
+
+  for (auto exponent = table_t::min_exponent; exponent <= table_t::max_exponent;
+       ++exponent)
+    for (auto count = 2; count <= 10; ++count)
+      for (auto dots = 0; dots <= 3; ++dots)
+      {
+        auto const i = table_t::index_of(exponent,
+                                         static_cast<tuplet>(count),
+                                         static_cast<dot_count>(dots));
+
+        keys[i] = ((std::int64_t(2520 / count) << (exponent + 17 - dots))
+                   * ((std::int64_t(2) << dots) - 1));
+
+        auto const gcd = binary_gcd(keys[i], scale);
+
+        table.numerators[i] = static_cast<fraction_rep_t>(keys[i] / gcd);
+        table.denominators[i] = static_cast<fraction_rep_t>(scale / gcd);
+      }
+
+  // Shell sort, then drop duplicates so that a key's rank is its position
+  auto sorted = keys;
+
+  for (auto gap = table_t::size / 2; gap > 0; gap /= 2)
+    for (auto i = gap; i < table_t::size; ++i)
+    {
+      auto const key = sorted[i];
+      auto j = i;
+
+      for (; j >= gap && sorted[j - gap] > key; j -= gap)
+        sorted[j] = sorted[j - gap];
+
+      sorted[j] = key;
+    }
+
+  auto num_unique = std::size_t(0);
+
+  for (auto i = std::size_t(0); i < table_t::size; ++i)
+    if (num_unique == 0 || sorted[num_unique - 1] != sorted[i])
+      sorted[num_unique++] = sorted[i];
+
+  for (auto i = std::size_t(0); i < table_t::size; ++i)
+  {
+    auto first = std::size_t(0);
+    auto last = num_unique;
+
+    while (first < last)
+    {
+      auto const middle = first + (last - first) / 2;
+
+      if (sorted[middle] < keys[i])
+        first = middle + 1;
+      else
+        last = middle;
+    }
+
+    table.ranks[i] = static_cast<std::uint16_t>(first);
+  }
+
+  return table;
+}
+
+static constexpr auto relative_values = make_relative_value_table();
+
+// The reduced products of tuplet_factor and dot_augmentation, whose terms are
+// at most 30 and 80, so that a relative value is one of them scaled by a power
+// of 2
+struct factor_table {
+  static constexpr std::size_t size = relative_value_table::num_tuplets
+                                      * relative_value_table::num_dot_counts;
+
+  static constexpr std::size_t index_of(tuplet const t,
+                                        dot_count const num_dots) noexcept
+  {
+    return static_cast<std::size_t>(to_underlying(t) - 2)
+             * relative_value_table::num_dot_counts
+           + static_cast<std::size_t>(to_underlying(num_dots));
+  }
+
+  std::array<std::int8_t, size> numerators {};
+  std::array<std::int8_t, size> denominators {};
+};
+
+constexpr factor_table make_factor_table() noexcept
+{
+  auto table = factor_table();
+
+  for (auto count = 2; count <= 10; ++count)
+    for (auto dots = 0; dots <= 3; ++dots)
+    {
+      auto const i = factor_table::index_of(static_cast<tuplet>(count),
+                                            static_cast<dot_count>(dots));
+
+      // (2 / count) (2^(dots + 1) - 1) / 2^dots
+      auto const numerator = 2 * ((2 << dots) - 1);
+      auto const denominator = count << dots;
+      auto const gcd = binary_gcd(numerator, denominator);
+
+      table.numerators[i] = static_cast<std::int8_t>(numerator / gcd);
+      table.denominators[i] = static_cast<std::int8_t>(denominator / gcd);
+    }
+
+  return table;
+}
+
+static constexpr auto factors = make_factor_table();
+
+// relative_value for note values outside the table, as the tuplet and dot
+// factor shifted by the exponent
+template <typename Rep>
+constexpr basic_fraction<Rep>
+computed_relative_value(basic_note_value<Rep> const& nv)
+{
+  auto const i = factor_table::index_of(nv.get_tuplet(), nv.get_num_dots());
+
+  return nv.get_power_of_2()
+         * basic_fraction<Rep>(static_cast<Rep>(factors.numerators[i]),
+                               static_cast<Rep>(factors.denominators[i]));
+}
+
 } // namespace detail
 
-constexpr fraction tuplet_factor(tuplet const t) noexcept
+template <typename Rep>
+constexpr basic_fraction<Rep> tuplet_factor(tuplet const t) noexcept
 {
-  return {2, detail::to_underlying(t)};
+  return {Rep(2), static_cast<Rep>(detail::to_underlying(t))};
 }
 
-constexpr fraction dot_augmentation(dot_count const num_dots) noexcept
+template <typename Rep>
+constexpr basic_fraction<Rep>
+dot_augmentation(dot_count const num_dots) noexcept
 {
-  return 2
-         - power_of_2(power_of_2::from_exponent,
-                      -detail::to_underlying(num_dots));
+  return basic_fraction<Rep>(Rep(2))
+         - basic_power_of_2<Rep>(basic_power_of_2<Rep>::from_exponent,
+                                 -detail::to_underlying(num_dots));
 }
 
-constexpr note_value::note_value(power_of_2 const _power_of_2,
-                                 tuplet const _tuplet,
-                                 dot_count const num_dots) noexcept :
+template <typename Rep>
+constexpr basic_note_value<Rep>::basic_note_value(
+  power_of_2_type const _power_of_2,
+  tuplet const _tuplet,
+  dot_count const num_dots) noexcept :
   power_of_2_ {_power_of_2}, tuplet_ {_tuplet}, num_dots_ {num_dots}
 {
 }
 
-constexpr note_value::note_value(power_of_2 const _power_of_2,
-                                 dot_count const num_dots) noexcept :
-  note_value {_power_of_2, tuplet::duplet, num_dots}
+template <typename Rep>
+constexpr basic_note_value<Rep>::basic_note_value(
+  power_of_2_type const _power_of_2,
+  dot_count const num_dots) noexcept :
+  basic_note_value {_power_of_2, tuplet::duplet, num_dots}
 {
 }
 
-constexpr note_value
-note_value::with(power_of_2 const new_power_of_2) const noexcept
+template <typename Rep>
+constexpr basic_note_value<Rep>
+basic_note_value<Rep>::with(power_of_2_type const new_power_of_2) const noexcept
 {
-  return note_value(new_power_of_2, tuplet_, num_dots_);
+  return basic_note_value(new_power_of_2, tuplet_, num_dots_);
 }
 
-constexpr note_value note_value::with(tuplet const new_tuplet) const noexcept
+template <typename Rep>
+constexpr basic_note_value<Rep>
+basic_note_value<Rep>::with(tuplet const new_tuplet) const noexcept
 {
-  return note_value(power_of_2_, new_tuplet, num_dots_);
+  return basic_note_value(power_of_2_, new_tuplet, num_dots_);
 }
 
-constexpr note_value
-note_value::with(dot_count const new_num_dots) const noexcept
+template <typename Rep>
+constexpr basic_note_value<Rep>
+basic_note_value<Rep>::with(dot_count const new_num_dots) const noexcept
 {
-  return note_value(power_of_2_, tuplet_, new_num_dots);
+  return basic_note_value(power_of_2_, tuplet_, new_num_dots);
 }
 
-constexpr fraction relative_value(note_value const& nv) noexcept
+template <typename Rep>
+constexpr basic_fraction<Rep>
+relative_value(basic_note_value<Rep> const& nv)
 {
-  return nv.get_power_of_2() * tuplet_factor(nv.get_tuplet())
-         * dot_augmentation(nv.get_num_dots());
+  if constexpr (std::numeric_limits<Rep>::digits
+                >= std::numeric_limits<fraction_rep_t>::digits)
+  {
+    auto const i = detail::relative_value_table::index_of(nv);
+
+    if (i < detail::relative_value_table::size)
+      return {static_cast<Rep>(detail::relative_values.numerators[i]),
+              static_cast<Rep>(detail::relative_values.denominators[i])};
+  }
+
+  return detail::computed_relative_value(nv);
 }
 
-constexpr bool operator==(note_value const& l, note_value const& r) noexcept
+template <typename Rep>
+constexpr bool operator==(basic_note_value<Rep> const& l,
+                          basic_note_value<Rep> const& r)
 {
+  auto const l_index = detail::relative_value_table::index_of(l);
+  auto const r_index = detail::relative_value_table::index_of(r);
+
+  if (l_index < detail::relative_value_table::size
+      && r_index < detail::relative_value_table::size)
+    return detail::relative_values.ranks[l_index]
+           == detail::relative_values.ranks[r_index];
+
   return relative_value(l) == relative_value(r);
 }
 
-constexpr bool operator!=(note_value const& l, note_value const& r) noexcept
+template <typename Rep>
+constexpr bool operator!=(basic_note_value<Rep> const& l,
+                          basic_note_value<Rep> const& r)
 {
   return !(l == r);
 }
 
-constexpr bool operator<(note_value const& l, note_value const& r) noexcept
+template <typename Rep>
+constexpr bool operator<(basic_note_value<Rep> const& l,
+                         basic_note_value<Rep> const& r)
 {
+  auto const l_index = detail::relative_value_table::index_of(l);
+  auto const r_index = detail::relative_value_table::index_of(r);
+
+  if (l_index < detail::relative_value_table::size
+      && r_index < detail::relative_value_table::size)
+    return detail::relative_values.ranks[l_index]
+           < detail::relative_values.ranks[r_index];
+
   return relative_value(l) < relative_value(r);
 }
 
-constexpr bool operator<=(note_value const& l, note_value const& r) noexcept
+template <typename Rep>
+constexpr bool operator<=(basic_note_value<Rep> const& l,
+                          basic_note_value<Rep> const& r)
 {
   return !(l > r);
 }
 
-constexpr bool operator>(note_value const& l, note_value const& r) noexcept
+template <typename Rep>
+constexpr bool operator>(basic_note_value<Rep> const& l,
+                         basic_note_value<Rep> const& r)
 {
   return r < l;
 }
 
-constexpr bool operator>=(note_value const& l, note_value const& r) noexcept
+template <typename Rep>
+constexpr bool operator>=(basic_note_value<Rep> const& l,
+                          basic_note_value<Rep> const& r)
 {
   return !(l < r);
 }
 
-constexpr note_value operator*(note_value const& l, power_of_2 const r) noexcept
+template <typename Rep>
+constexpr basic_note_value<Rep>
+operator*(basic_note_value<Rep> const& l,
+          basic_power_of_2<Rep> const r) noexcept
 {
   return l.with(l.get_power_of_2() * r);
 }
 
-constexpr note_value operator*(power_of_2 const l, note_value const& r) noexcept
+template <typename Rep>
+constexpr basic_note_value<Rep>
+operator*(basic_power_of_2<Rep> const l,
+          basic_note_value<Rep> const& r) noexcept
 {
   return r * l;
 }
 
-constexpr fraction operator/(note_value const& l, note_value const& r) noexcept
+template <typename Rep>
+constexpr basic_fraction<Rep> operator/(basic_note_value<Rep> const& l,
+                                        basic_note_value<Rep> const& r)
 {
   return relative_value(l) / relative_value(r);
 }
 
-constexpr note_value operator/(note_value const& l, power_of_2 const r) noexcept
+template <typename Rep>
+constexpr basic_note_value<Rep>
+operator/(basic_note_value<Rep> const& l,
+          basic_power_of_2<Rep> const r) noexcept
 {
   return l.with(l.get_power_of_2() / r);
 }
 
-constexpr fraction operator%(note_value const& l, note_value const& r) noexcept
+template <typename Rep>
+constexpr basic_fraction<Rep> operator%(basic_note_value<Rep> const& l,
+                                        basic_note_value<Rep> const& r)
 {
   return relative_value(l) % relative_value(r);
 }
@@ -0,0 +1,370 @@
+#ifndef CBB_NOTE_VALUE_CODE_HPP
+#define CBB_NOTE_VALUE_CODE_HPP
+
+#include <cbb/note_value.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+
+namespace cbb {
+
+
+// A note value packed into 16 bits: the number of dots in bits 0-1, the tuplet
+// count minus 2 in bits 2-5 and the exponent of the power of 2 in bits 6-15 as
+// a two's complement integer. The default code is the whole note, as is the
+// default note value.
+class note_value_code final {
+
+public:
+  static constexpr int min_exponent = -512;
+  static constexpr int max_exponent = 511;
+
+  constexpr note_value_code() noexcept = default;
+
+  // Throws std::overflow_error if the exponent is outside [min_exponent,
+  // max_exponent]
+  template <typename Rep>
+  explicit constexpr note_value_code(basic_note_value<Rep> const& nv);
+
+  // Throws std::invalid_argument if the tuplet field is not that of a tuplet,
+  // i.e. the count minus 2 is greater than that of the decuplet
+  static constexpr note_value_code from_bits(std::uint16_t bits);
+
+  constexpr std::uint16_t get_bits() const noexcept { return bits_; }
+
+  constexpr int get_exponent() const noexcept;
+
+  constexpr tuplet get_tuplet() const noexcept;
+
+  constexpr dot_count get_num_dots() const noexcept;
+
+private:
+  static constexpr int tuplet_shift = 2;
+  static constexpr int exponent_shift = 6;
+
+  std::uint16_t bits_ = 0;
+};
+
+// Equality of codes, i.e. of the exponent, tuplet and dots. Note values with
+// equal relative values can have different codes.
+constexpr bool operator==(note_value_code l, note_value_code r) noexcept;
+constexpr bool operator!=(note_value_code l, note_value_code r) noexcept;
+
+// Throws std::overflow_error if the exponent does not fit in a code
+template <typename Rep>
+constexpr note_value_code encode(basic_note_value<Rep> const& nv);
+
+template <typename Rep = fraction_rep_t>
+constexpr basic_note_value<Rep> decode(note_value_code code) noexcept;
+
+
+// A sequence of note values stored as contiguous note_value_codes, a sixth of
+// the size of a std::vector<note_value>. Elements are decoded as they are read,
+// so element access and iteration return note values by value.
+class packed_note_value_vector final {
+
+public:
+  using value_type = note_value;
+  using size_type = std::size_t;
+  using difference_type = std::ptrdiff_t;
+
+  class const_iterator;
+
+  packed_note_value_vector() noexcept = default;
+
+  // Throws std::overflow_error if an exponent does not fit in a code
+  template <typename InputIt>
+  packed_note_value_vector(InputIt first, InputIt last);
+
+  packed_note_value_vector(std::initializer_list<note_value> note_values);
+
+  note_value operator[](size_type pos) const noexcept;
+
+  // Throws std::out_of_range if pos is not less than size()
+  note_value at(size_type pos) const;
+
+  note_value front() const noexcept { return (*this)[0]; }
+
+  note_value back() const noexcept { return (*this)[size() - 1]; }
+
+  // Throws std::overflow_error if the exponent does not fit in a code
+  void set(size_type pos, note_value const& nv);
+
+  note_value_code const* data() const noexcept { return codes_.data(); }
+
+  const_iterator begin() const noexcept;
+  const_iterator end() const noexcept;
+
+  bool empty() const noexcept { return codes_.empty(); }
+
+  size_type size() const noexcept { return codes_.size(); }
+
+  size_type capacity() const noexcept { return codes_.capacity(); }
+
+  void reserve(size_type new_capacity) { codes_.reserve(new_capacity); }
+
+  void shrink_to_fit() { codes_.shrink_to_fit(); }
+
+  void clear() noexcept { codes_.clear(); }
+
+  // Throws std::overflow_error if the exponent does not fit in a code
+  void push_back(note_value const& nv);
+
+  void pop_back() noexcept { codes_.pop_back(); }
+
+  void resize(size_type count) { codes_.resize(count); }
+
+private:
+  std::vector<note_value_code> codes_;
+};
+
+class packed_note_value_vector::const_iterator final {
+
+public:
+  using iterator_category = std::random_access_iterator_tag;
+  using value_type = note_value;
+  using difference_type = std::ptrdiff_t;
+  using pointer = void;
+  using reference = note_value;
+
+  const_iterator() noexcept = default;
+
+  explicit const_iterator(note_value_code const* code) noexcept : code_ {code}
+  {
+  }
+
+  note_value operator*() const noexcept { return decode(*code_); }
+
+  note_value operator[](difference_type n) const noexcept
+  {
+    return decode(code_[n]);
+  }
+
+  const_iterator& operator++() noexcept
+  {
+    ++code_;
+    return *this;
+  }
+
+  const_iterator operator++(int) noexcept { return const_iterator(code_++); }
+
+  const_iterator& operator--() noexcept
+  {
+    --code_;
+    return *this;
+  }
+
+  const_iterator operator--(int) noexcept { return const_iterator(code_--); }
+
+  const_iterator& operator+=(difference_type n) noexcept
+  {
+    code_ += n;
+    return *this;
+  }
+
+  const_iterator& operator-=(difference_type n) noexcept
+  {
+    code_ -= n;
+    return *this;
+  }
+
+  friend const_iterator operator+(const_iterator it, difference_type n) noexcept
+  {
+    return it += n;
+  }
+
+  friend const_iterator operator+(difference_type n, const_iterator it) noexcept
+  {
+    return it += n;
+  }
+
+  friend const_iterator operator-(const_iterator it, difference_type n) noexcept
+  {
+    return it -= n;
+  }
+
+  friend difference_type operator-(const_iterator l, const_iterator r) noexcept
+  {
+    return l.code_ - r.code_;
+  }
+
+  friend bool operator==(const_iterator l, const_iterator r) noexcept
+  {
+    return l.code_ == r.code_;
+  }
+
+  friend bool operator!=(const_iterator l, const_iterator r) noexcept
+  {
+    return l.code_ != r.code_;
+  }
+
+  friend bool operator<(const_iterator l, const_iterator r) noexcept
+  {
+    return l.code_ < r.code_;
+  }
+
+  friend bool operator<=(const_iterator l, const_iterator r) noexcept
+  {
+    return l.code_ <= r.code_;
+  }
+
+  friend bool operator>(const_iterator l, const_iterator r) noexcept
+  {
+    return l.code_ > r.code_;
+  }
+
+  friend bool operator>=(const_iterator l, const_iterator r) noexcept
+  {
+    return l.code_ >= r.code_;
+  }
+
+private:
+  note_value_code const* code_ = nullptr;
+};
+
+
+// =============================================================================
+
+
+template <typename Rep>
+constexpr note_value_code::note_value_code(basic_note_value<Rep> const& nv)
+{
+  auto const exponent = nv.get_power_of_2().get_exponent();
+
+  if (exponent < min_exponent || exponent > max_exponent)
+    throw std::overflow_error("the exponent does not fit in a note_value_code");
+
+  bits_ = static_cast<std::uint16_t>(
+    (static_cast<unsigned>(exponent) << exponent_shift)
+    | (static_cast<unsigned>(detail::to_underlying(nv.get_tuplet()) - 2)
+       << tuplet_shift)
+    | static_cast<unsigned>(detail::to_underlying(nv.get_num_dots())));
+}
+
+constexpr note_value_code
+note_value_code::from_bits(std::uint16_t const bits)
+{
+  auto const max_tuplet_field
+    = static_cast<unsigned>(detail::to_underlying(tuplet::decuplet) - 2);
+
+  if (((bits >> tuplet_shift) & 0xFu) > max_tuplet_field)
+    throw std::invalid_argument("the bits do not encode a tuplet");
+
+  auto code = note_value_code();
+  code.bits_ = bits;
+
+  return code;
+}
+
+constexpr int note_value_code::get_exponent() const noexcept
+{
+  // Sign extends the 10 bit field
+  return (static_cast<int>(bits_ >> exponent_shift) ^ 0x200) - 0x200;
+}
+
+constexpr tuplet note_value_code::get_tuplet() const noexcept
+{
+  return static_cast<tuplet>(((bits_ >> tuplet_shift) & 0xF) + 2);
+}
+
+constexpr dot_count note_value_code::get_num_dots() const noexcept
+{
+  return static_cast<dot_count>(bits_ & 0x3);
+}
+
+constexpr bool operator==(note_value_code const l,
+                          note_value_code const r) noexcept
+{
+  return l.get_bits() == r.get_bits();
+}
+
+constexpr bool operator!=(note_value_code const l,
+                          note_value_code const r) noexcept
+{
+  return !(l == r);
+}
+
+template <typename Rep>
+constexpr note_value_code encode(basic_note_value<Rep> const& nv)
+{
+  return note_value_code(nv);
+}
+
+template <typename Rep>
+constexpr basic_note_value<Rep> decode(note_value_code const code) noexcept
+{
+  using power_of_2_type = basic_power_of_2<Rep>;
+
+  return basic_note_value<Rep>(
+    power_of_2_type(power_of_2_type::from_exponent, code.get_exponent()),
+    code.get_tuplet(),
+    code.get_num_dots());
+}
+
+template <typename InputIt>
+packed_note_value_vector::packed_note_value_vector(InputIt first,
+                                                   InputIt const last)
+{
+  if constexpr (std::is_base_of_v<
+                  std::forward_iterator_tag,
+                  typename std::iterator_traits<InputIt>::iterator_category>)
+    codes_.reserve(static_cast<size_type>(std::distance(first, last)));
+
+  for (; first != last; ++first)
+    codes_.push_back(encode(*first));
+}
+
+inline packed_note_value_vector::packed_note_value_vector(
+  std::initializer_list<note_value> const note_values) :
+  packed_note_value_vector(note_values.begin(), note_values.end())
+{
+}
+
+inline note_value
+packed_note_value_vector::operator[](size_type const pos) const noexcept
+{
+  return decode(codes_[pos]);
+}
+
+inline note_value packed_note_value_vector::at(size_type const pos) const
+{
+  if (pos >= size())
+    throw std::out_of_range("the position is past the end of the vector");
+
+  return (*this)[pos];
+}
+
+inline void packed_note_value_vector::set(size_type const pos,
+                                          note_value const& nv)
+{
+  codes_[pos] = encode(nv);
+}
+
+inline packed_note_value_vector::const_iterator
+packed_note_value_vector::begin() const noexcept
+{
+  return const_iterator(codes_.data());
+}
+
+inline packed_note_value_vector::const_iterator
+packed_note_value_vector::end() const noexcept
+{
+  return const_iterator(codes_.data() + codes_.size());
+}
+
+inline void packed_note_value_vector::push_back(note_value const& nv)
+{
+  codes_.push_back(encode(nv));
+}
+
+
+} // namespace cbb
+
+
+#endif
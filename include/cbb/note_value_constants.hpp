@@ -7,60 +7,194 @@
 namespace cbb {
 
 
-static constexpr auto _256th_note = note_value(numbers::one_256th);
-static constexpr auto _128th_note = note_value(numbers::one_128th);
-static constexpr auto _64th_note = note_value(numbers::one_64th);
-static constexpr auto _32nd_note = note_value(numbers::one_32nd);
-static constexpr auto _16th_note = note_value(numbers::one_16th);
-static constexpr auto _8th_note = note_value(numbers::one_8th);
-static constexpr auto quarter_note = note_value(numbers::one_quarter);
-static constexpr auto half_note = note_value(numbers::one_half);
-static constexpr auto whole_note = note_value(numbers::_1);
-static constexpr auto double_whole_note = note_value(numbers::_2);
-static constexpr auto quadruple_whole_note = note_value(numbers::_4);
-static constexpr auto octuple_whole_note = note_value(numbers::_8);
-
-static constexpr auto demisemihemidemisemiquaver = _256th_note;
-static constexpr auto semihemidemisemiquaver = _128th_note;
-static constexpr auto hemidemisemiquaver = _64th_note;
-static constexpr auto demisemiquaver = _32nd_note;
-static constexpr auto semiquaver = _16th_note;
-static constexpr auto quaver = _8th_note;
-static constexpr auto crotchet = quarter_note;
-static constexpr auto minim = half_note;
-static constexpr auto semibreve = whole_note;
-static constexpr auto breve = double_whole_note;
-static constexpr auto longa = quadruple_whole_note;
-static constexpr auto maxima = octuple_whole_note;
-
-static constexpr auto triplet_256th_note = _256th_note.with(tuplet::triplet);
-static constexpr auto triplet_128th_note = _128th_note.with(tuplet::triplet);
-static constexpr auto triplet_64th_note = _64th_note.with(tuplet::triplet);
-static constexpr auto triplet_32nd_note = _32nd_note.with(tuplet::triplet);
-static constexpr auto triplet_16th_note = _16th_note.with(tuplet::triplet);
-static constexpr auto triplet_8th_note = _8th_note.with(tuplet::triplet);
-static constexpr auto triplet_quarter_note = quarter_note.with(tuplet::triplet);
-static constexpr auto triplet_half_note = half_note.with(tuplet::triplet);
-static constexpr auto triplet_whole_note = whole_note.with(tuplet::triplet);
+template <typename Rep>
+static constexpr auto _256th_note_v
+  = basic_note_value<Rep>(numbers::one_256th_v<Rep>);
+template <typename Rep>
+static constexpr auto _128th_note_v
+  = basic_note_value<Rep>(numbers::one_128th_v<Rep>);
+template <typename Rep>
+static constexpr auto _64th_note_v
+  = basic_note_value<Rep>(numbers::one_64th_v<Rep>);
+template <typename Rep>
+static constexpr auto _32nd_note_v
+  = basic_note_value<Rep>(numbers::one_32nd_v<Rep>);
+template <typename Rep>
+static constexpr auto _16th_note_v
+  = basic_note_value<Rep>(numbers::one_16th_v<Rep>);
+template <typename Rep>
+static constexpr auto _8th_note_v
+  = basic_note_value<Rep>(numbers::one_8th_v<Rep>);
+template <typename Rep>
+static constexpr auto quarter_note_v
+  = basic_note_value<Rep>(numbers::one_quarter_v<Rep>);
+template <typename Rep>
+static constexpr auto half_note_v
+  = basic_note_value<Rep>(numbers::one_half_v<Rep>);
+template <typename Rep>
+static constexpr auto whole_note_v = basic_note_value<Rep>(numbers::_1_v<Rep>);
+template <typename Rep>
+static constexpr auto double_whole_note_v
+  = basic_note_value<Rep>(numbers::_2_v<Rep>);
+template <typename Rep>
+static constexpr auto quadruple_whole_note_v
+  = basic_note_value<Rep>(numbers::_4_v<Rep>);
+template <typename Rep>
+static constexpr auto octuple_whole_note_v
+  = basic_note_value<Rep>(numbers::_8_v<Rep>);
+
+template <typename Rep>
+static constexpr auto demisemihemidemisemiquaver_v = _256th_note_v<Rep>;
+template <typename Rep>
+static constexpr auto semihemidemisemiquaver_v = _128th_note_v<Rep>;
+template <typename Rep>
+static constexpr auto hemidemisemiquaver_v = _64th_note_v<Rep>;
+template <typename Rep>
+static constexpr auto demisemiquaver_v = _32nd_note_v<Rep>;
+template <typename Rep>
+static constexpr auto semiquaver_v = _16th_note_v<Rep>;
+template <typename Rep>
+static constexpr auto quaver_v = _8th_note_v<Rep>;
+template <typename Rep>
+static constexpr auto crotchet_v = quarter_note_v<Rep>;
+template <typename Rep>
+static constexpr auto minim_v = half_note_v<Rep>;
+template <typename Rep>
+static constexpr auto semibreve_v = whole_note_v<Rep>;
+template <typename Rep>
+static constexpr auto breve_v = double_whole_note_v<Rep>;
+template <typename Rep>
+static constexpr auto longa_v = quadruple_whole_note_v<Rep>;
+template <typename Rep>
+static constexpr auto maxima_v = octuple_whole_note_v<Rep>;
+
+template <typename Rep>
+static constexpr auto triplet_256th_note_v
+  = _256th_note_v<Rep>.with(tuplet::triplet);
+template <typename Rep>
+static constexpr auto triplet_128th_note_v
+  = _128th_note_v<Rep>.with(tuplet::triplet);
+template <typename Rep>
+static constexpr auto triplet_64th_note_v
+  = _64th_note_v<Rep>.with(tuplet::triplet);
+template <typename Rep>
+static constexpr auto triplet_32nd_note_v
+  = _32nd_note_v<Rep>.with(tuplet::triplet);
+template <typename Rep>
+static constexpr auto triplet_16th_note_v
+  = _16th_note_v<Rep>.with(tuplet::triplet);
+template <typename Rep>
+static constexpr auto triplet_8th_note_v
+  = _8th_note_v<Rep>.with(tuplet::triplet);
+template <typename Rep>
+static constexpr auto triplet_quarter_note_v
+  = quarter_note_v<Rep>.with(tuplet::triplet);
+template <typename Rep>
+static constexpr auto triplet_half_note_v
+  = half_note_v<Rep>.with(tuplet::triplet);
+template <typename Rep>
+static constexpr auto triplet_whole_note_v
+  = whole_note_v<Rep>.with(tuplet::triplet);
+template <typename Rep>
+static constexpr auto triplet_double_whole_note_v
+  = double_whole_note_v<Rep>.with(tuplet::triplet);
+template <typename Rep>
+static constexpr auto triplet_quadruple_whole_note_v
+  = quadruple_whole_note_v<Rep>.with(tuplet::triplet);
+template <typename Rep>
+static constexpr auto triplet_octuple_whole_note_v
+  = octuple_whole_note_v<Rep>.with(tuplet::triplet);
+
+template <typename Rep>
+static constexpr auto triplet_demisemihemidemisemiquaver_v
+  = triplet_256th_note_v<Rep>;
+template <typename Rep>
+static constexpr auto triplet_semihemidemisemiquaver_v
+  = triplet_128th_note_v<Rep>;
+template <typename Rep>
+static constexpr auto triplet_hemidemisemiquaver_v = triplet_64th_note_v<Rep>;
+template <typename Rep>
+static constexpr auto triplet_demisemiquaver_v = triplet_32nd_note_v<Rep>;
+template <typename Rep>
+static constexpr auto triplet_semiquaver_v = triplet_16th_note_v<Rep>;
+template <typename Rep>
+static constexpr auto triplet_quaver_v = triplet_8th_note_v<Rep>;
+template <typename Rep>
+static constexpr auto triplet_crotchet_v = triplet_quarter_note_v<Rep>;
+template <typename Rep>
+static constexpr auto triplet_minim_v = triplet_half_note_v<Rep>;
+template <typename Rep>
+static constexpr auto triplet_semibreve_v = triplet_whole_note_v<Rep>;
+template <typename Rep>
+static constexpr auto triplet_breve_v = triplet_double_whole_note_v<Rep>;
+template <typename Rep>
+static constexpr auto triplet_longa_v = triplet_quadruple_whole_note_v<Rep>;
+template <typename Rep>
+static constexpr auto triplet_maxima_v = triplet_octuple_whole_note_v<Rep>;
+
+
+static constexpr auto _256th_note = _256th_note_v<fraction_rep_t>;
+static constexpr auto _128th_note = _128th_note_v<fraction_rep_t>;
+static constexpr auto _64th_note = _64th_note_v<fraction_rep_t>;
+static constexpr auto _32nd_note = _32nd_note_v<fraction_rep_t>;
+static constexpr auto _16th_note = _16th_note_v<fraction_rep_t>;
+static constexpr auto _8th_note = _8th_note_v<fraction_rep_t>;
+static constexpr auto quarter_note = quarter_note_v<fraction_rep_t>;
+static constexpr auto half_note = half_note_v<fraction_rep_t>;
+static constexpr auto whole_note = whole_note_v<fraction_rep_t>;
+static constexpr auto double_whole_note = double_whole_note_v<fraction_rep_t>;
+static constexpr auto quadruple_whole_note
+  = quadruple_whole_note_v<fraction_rep_t>;
+static constexpr auto octuple_whole_note = octuple_whole_note_v<fraction_rep_t>;
+
+static constexpr auto demisemihemidemisemiquaver
+  = demisemihemidemisemiquaver_v<fraction_rep_t>;
+static constexpr auto semihemidemisemiquaver
+  = semihemidemisemiquaver_v<fraction_rep_t>;
+static constexpr auto hemidemisemiquaver = hemidemisemiquaver_v<fraction_rep_t>;
+static constexpr auto demisemiquaver = demisemiquaver_v<fraction_rep_t>;
+static constexpr auto semiquaver = semiquaver_v<fraction_rep_t>;
+static constexpr auto quaver = quaver_v<fraction_rep_t>;
+static constexpr auto crotchet = crotchet_v<fraction_rep_t>;
+static constexpr auto minim = minim_v<fraction_rep_t>;
+static constexpr auto semibreve = semibreve_v<fraction_rep_t>;
+static constexpr auto breve = breve_v<fraction_rep_t>;
+static constexpr auto longa = longa_v<fraction_rep_t>;
+static constexpr auto maxima = maxima_v<fraction_rep_t>;
+
+static constexpr auto triplet_256th_note = triplet_256th_note_v<fraction_rep_t>;
+static constexpr auto triplet_128th_note = triplet_128th_note_v<fraction_rep_t>;
+static constexpr auto triplet_64th_note = triplet_64th_note_v<fraction_rep_t>;
+static constexpr auto triplet_32nd_note = triplet_32nd_note_v<fraction_rep_t>;
+static constexpr auto triplet_16th_note = triplet_16th_note_v<fraction_rep_t>;
+static constexpr auto triplet_8th_note = triplet_8th_note_v<fraction_rep_t>;
+static constexpr auto triplet_quarter_note
+  = triplet_quarter_note_v<fraction_rep_t>;
+static constexpr auto triplet_half_note = triplet_half_note_v<fraction_rep_t>;
+static constexpr auto triplet_whole_note = triplet_whole_note_v<fraction_rep_t>;
 static constexpr auto triplet_double_whole_note
-  = double_whole_note.with(tuplet::triplet);
+  = triplet_double_whole_note_v<fraction_rep_t>;
 static constexpr auto triplet_quadruple_whole_note
-  = quadruple_whole_note.with(tuplet::triplet);
+  = triplet_quadruple_whole_note_v<fraction_rep_t>;
 static constexpr auto triplet_octuple_whole_note
-  = octuple_whole_note.with(tuplet::triplet);
-
-static constexpr auto triplet_demisemihemidemisemiquaver = triplet_256th_note;
-static constexpr auto triplet_semihemidemisemiquaver = triplet_128th_note;
-static constexpr auto triplet_hemidemisemiquaver = triplet_64th_note;
-static constexpr auto triplet_demisemiquaver = triplet_32nd_note;
-static constexpr auto triplet_semiquaver = triplet_16th_note;
-static constexpr auto triplet_quaver = triplet_8th_note;
-static constexpr auto triplet_crotchet = triplet_quarter_note;
-static constexpr auto triplet_minim = triplet_half_note;
-static constexpr auto triplet_semibreve = triplet_whole_note;
-static constexpr auto triplet_breve = triplet_double_whole_note;
-static constexpr auto triplet_longa = triplet_quadruple_whole_note;
-static constexpr auto triplet_maxima = triplet_octuple_whole_note;
+  = triplet_octuple_whole_note_v<fraction_rep_t>;
+
+static constexpr auto triplet_demisemihemidemisemiquaver
+  = triplet_demisemihemidemisemiquaver_v<fraction_rep_t>;
+static constexpr auto triplet_semihemidemisemiquaver
+  = triplet_semihemidemisemiquaver_v<fraction_rep_t>;
+static constexpr auto triplet_hemidemisemiquaver
+  = triplet_hemidemisemiquaver_v<fraction_rep_t>;
+static constexpr auto triplet_demisemiquaver
+  = triplet_demisemiquaver_v<fraction_rep_t>;
+static constexpr auto triplet_semiquaver = triplet_semiquaver_v<fraction_rep_t>;
+static constexpr auto triplet_quaver = triplet_quaver_v<fraction_rep_t>;
+static constexpr auto triplet_crotchet = triplet_crotchet_v<fraction_rep_t>;
+static constexpr auto triplet_minim = triplet_minim_v<fraction_rep_t>;
+static constexpr auto triplet_semibreve = triplet_semibreve_v<fraction_rep_t>;
+static constexpr auto triplet_breve = triplet_breve_v<fraction_rep_t>;
+static constexpr auto triplet_longa = triplet_longa_v<fraction_rep_t>;
+static constexpr auto triplet_maxima = triplet_maxima_v<fraction_rep_t>;
 
 
 } // namespace cbb
@@ -3,346 +3,620 @@
 
 #include <cbb/fraction.hpp>
 
-#include <bitset>
+#include <limits>
+#include <optional>
 #include <stdexcept>
+#include <type_traits>
 
 
 namespace cbb {
 
 
-class power_of_2 {
+namespace detail {
 
-public:
-  constexpr power_of_2() noexcept = default;
+struct from_exponent_t {
+  explicit constexpr from_exponent_t() noexcept = default;
+};
 
-  explicit constexpr power_of_2(fraction value);
+// Keeps the fraction operand of a mixed operator from taking part in
+// deduction, so that integers and literals still convert to it
+template <typename Rep>
+struct fraction_of {
+  using type = basic_fraction<Rep>;
+};
 
-  struct from_exponent_t {
-    explicit constexpr from_exponent_t() noexcept = default;
-  };
+template <typename Rep>
+using fraction_of_t = typename fraction_of<Rep>::type;
 
-  static constexpr auto from_exponent = from_exponent_t {};
+} // namespace detail
 
-  constexpr power_of_2(from_exponent_t, int exponent) noexcept;
 
-  constexpr int get_exponent() const noexcept { return exponent_; }
+template <typename Rep>
+class basic_power_of_2 {
 
-  constexpr fraction get_value() const noexcept;
+public:
+  using rep_type = Rep;
+  using fraction_type = basic_fraction<Rep>;
 
-  explicit operator fraction() const noexcept { return get_value(); }
+  constexpr basic_power_of_2() noexcept = default;
 
-private:
-  friend constexpr bool operator==(power_of_2 l, power_of_2 r) noexcept;
-  friend constexpr bool operator<(power_of_2 l, power_of_2 r) noexcept;
+  explicit constexpr basic_power_of_2(fraction_type value);
 
-  friend constexpr power_of_2 operator*(power_of_2 l, power_of_2 r) noexcept;
-  friend constexpr power_of_2 operator/(power_of_2 l, power_of_2 r) noexcept;
+  using from_exponent_t = detail::from_exponent_t;
 
-  int exponent_ = 0;
-};
+  static constexpr auto from_exponent = from_exponent_t {};
 
-constexpr bool operator==(power_of_2 l, power_of_2 r) noexcept;
-constexpr bool operator==(power_of_2 l, fraction const& r) noexcept;
-constexpr bool operator==(fraction const& l, power_of_2 r) noexcept;
+  constexpr basic_power_of_2(from_exponent_t, int exponent) noexcept;
 
-constexpr bool operator!=(power_of_2 l, power_of_2 r) noexcept;
-constexpr bool operator!=(power_of_2 l, fraction const& r) noexcept;
-constexpr bool operator!=(fraction const& l, power_of_2 r) noexcept;
+  constexpr int get_exponent() const noexcept { return exponent_; }
 
-constexpr bool operator<(power_of_2 l, power_of_2 r) noexcept;
-constexpr bool operator<(power_of_2 l, fraction const& r) noexcept;
-constexpr bool operator<(fraction const& l, power_of_2 r) noexcept;
+  constexpr fraction_type get_value() const noexcept;
 
-constexpr bool operator<=(power_of_2 l, power_of_2 r) noexcept;
-constexpr bool operator<=(power_of_2 l, fraction const& r) noexcept;
-constexpr bool operator<=(fraction const& l, power_of_2 r) noexcept;
+  explicit operator fraction_type() const noexcept { return get_value(); }
 
-constexpr bool operator>(power_of_2 l, power_of_2 r) noexcept;
-constexpr bool operator>(power_of_2 l, fraction const& r) noexcept;
-constexpr bool operator>(fraction const& l, power_of_2 r) noexcept;
+private:
+  int exponent_ = 0;
+};
 
-constexpr bool operator>=(power_of_2 l, power_of_2 r) noexcept;
-constexpr bool operator>=(power_of_2 l, fraction const& r) noexcept;
-constexpr bool operator>=(fraction const& l, power_of_2 r) noexcept;
+using power_of_2 = basic_power_of_2<fraction_rep_t>;
+
+// The power of 2 equal to the value, or std::nullopt if the value is not one.
+// Unlike the constructor, it does not throw.
+template <typename Rep>
+constexpr std::optional<basic_power_of_2<Rep>>
+try_make_power_of_2(basic_fraction<Rep> const& value) noexcept;
+
+template <typename Rep>
+constexpr bool operator==(basic_power_of_2<Rep> l,
+                          basic_power_of_2<Rep> r) noexcept;
+template <typename Rep>
+constexpr bool operator==(basic_power_of_2<Rep> l,
+                          detail::fraction_of_t<Rep> const& r) noexcept;
+template <typename Rep>
+constexpr bool operator==(detail::fraction_of_t<Rep> const& l,
+                          basic_power_of_2<Rep> r) noexcept;
+
+template <typename Rep>
+constexpr bool operator!=(basic_power_of_2<Rep> l,
+                          basic_power_of_2<Rep> r) noexcept;
+template <typename Rep>
+constexpr bool operator!=(basic_power_of_2<Rep> l,
+                          detail::fraction_of_t<Rep> const& r) noexcept;
+template <typename Rep>
+constexpr bool operator!=(detail::fraction_of_t<Rep> const& l,
+                          basic_power_of_2<Rep> r) noexcept;
+
+template <typename Rep>
+constexpr bool operator<(basic_power_of_2<Rep> l,
+                         basic_power_of_2<Rep> r) noexcept;
+template <typename Rep>
+constexpr bool operator<(basic_power_of_2<Rep> l,
+                         detail::fraction_of_t<Rep> const& r) noexcept;
+template <typename Rep>
+constexpr bool operator<(detail::fraction_of_t<Rep> const& l,
+                         basic_power_of_2<Rep> r) noexcept;
+
+template <typename Rep>
+constexpr bool operator<=(basic_power_of_2<Rep> l,
+                          basic_power_of_2<Rep> r) noexcept;
+template <typename Rep>
+constexpr bool operator<=(basic_power_of_2<Rep> l,
+                          detail::fraction_of_t<Rep> const& r) noexcept;
+template <typename Rep>
+constexpr bool operator<=(detail::fraction_of_t<Rep> const& l,
+                          basic_power_of_2<Rep> r) noexcept;
+
+template <typename Rep>
+constexpr bool operator>(basic_power_of_2<Rep> l,
+                         basic_power_of_2<Rep> r) noexcept;
+template <typename Rep>
+constexpr bool operator>(basic_power_of_2<Rep> l,
+                         detail::fraction_of_t<Rep> const& r) noexcept;
+template <typename Rep>
+constexpr bool operator>(detail::fraction_of_t<Rep> const& l,
+                         basic_power_of_2<Rep> r) noexcept;
+
+template <typename Rep>
+constexpr bool operator>=(basic_power_of_2<Rep> l,
+                          basic_power_of_2<Rep> r) noexcept;
+template <typename Rep>
+constexpr bool operator>=(basic_power_of_2<Rep> l,
+                          detail::fraction_of_t<Rep> const& r) noexcept;
+template <typename Rep>
+constexpr bool operator>=(detail::fraction_of_t<Rep> const& l,
+                          basic_power_of_2<Rep> r) noexcept;
+
+template <typename Rep>
+constexpr basic_power_of_2<Rep> operator+(basic_power_of_2<Rep> p) noexcept;
+template <typename Rep>
+constexpr basic_fraction<Rep> operator-(basic_power_of_2<Rep> p) noexcept;
+
+template <typename Rep>
+constexpr basic_fraction<Rep> operator+(basic_power_of_2<Rep> l,
+                                        basic_power_of_2<Rep> r) noexcept;
+template <typename Rep>
+constexpr basic_fraction<Rep>
+operator+(basic_power_of_2<Rep> l,
+          detail::fraction_of_t<Rep> const& r) noexcept;
+template <typename Rep>
+constexpr basic_fraction<Rep> operator+(detail::fraction_of_t<Rep> const& l,
+                                        basic_power_of_2<Rep> r) noexcept;
+
+template <typename Rep>
+constexpr basic_fraction<Rep> operator-(basic_power_of_2<Rep> l,
+                                        basic_power_of_2<Rep> r) noexcept;
+template <typename Rep>
+constexpr basic_fraction<Rep>
+operator-(basic_power_of_2<Rep> l,
+          detail::fraction_of_t<Rep> const& r) noexcept;
+template <typename Rep>
+constexpr basic_fraction<Rep> operator-(detail::fraction_of_t<Rep> const& l,
+                                        basic_power_of_2<Rep> r) noexcept;
+
+// Products and quotients of a power of 2 and a fraction only shift a term of
+// the fraction, cancelling factors of 2 first. They throw std::overflow_error
+// if a term of the result does not fit in Rep.
+template <typename Rep>
+constexpr basic_power_of_2<Rep> operator*(basic_power_of_2<Rep> l,
+                                          basic_power_of_2<Rep> r) noexcept;
+template <typename Rep>
+constexpr basic_fraction<Rep>
+operator*(basic_power_of_2<Rep> l,
+          detail::fraction_of_t<Rep> const& r);
+template <typename Rep>
+constexpr basic_fraction<Rep> operator*(detail::fraction_of_t<Rep> const& l,
+                                        basic_power_of_2<Rep> r);
+
+template <typename Rep>
+constexpr basic_power_of_2<Rep> operator/(basic_power_of_2<Rep> l,
+                                          basic_power_of_2<Rep> r) noexcept;
+template <typename Rep>
+constexpr basic_fraction<Rep>
+operator/(basic_power_of_2<Rep> l,
+          detail::fraction_of_t<Rep> const& r);
+template <typename Rep>
+constexpr basic_fraction<Rep> operator/(detail::fraction_of_t<Rep> const& l,
+                                        basic_power_of_2<Rep> r);
+
+template <typename Rep>
+constexpr basic_fraction<Rep> operator%(basic_power_of_2<Rep> l,
+                                        basic_power_of_2<Rep> r) noexcept;
+template <typename Rep>
+constexpr basic_fraction<Rep>
+operator%(basic_power_of_2<Rep> l,
+          detail::fraction_of_t<Rep> const& r) noexcept;
+template <typename Rep>
+constexpr basic_fraction<Rep> operator%(detail::fraction_of_t<Rep> const& l,
+                                        basic_power_of_2<Rep> r) noexcept;
+
+template <typename Rep>
+constexpr basic_power_of_2<Rep>& operator*=(basic_power_of_2<Rep>& l,
+                                            basic_power_of_2<Rep> r) noexcept;
+template <typename Rep>
+constexpr basic_power_of_2<Rep>& operator/=(basic_power_of_2<Rep>& l,
+                                            basic_power_of_2<Rep> r) noexcept;
 
-constexpr power_of_2 operator+(power_of_2 p) noexcept;
-constexpr fraction operator-(power_of_2 p) noexcept;
 
-constexpr fraction operator+(power_of_2 l, power_of_2 r) noexcept;
-constexpr fraction operator+(power_of_2 l, fraction const& r) noexcept;
-constexpr fraction operator+(fraction const& l, power_of_2 r) noexcept;
+// =================================================================================================
 
-constexpr fraction operator-(power_of_2 l, power_of_2 r) noexcept;
-constexpr fraction operator-(power_of_2 l, fraction const& r) noexcept;
-constexpr fraction operator-(fraction const& l, power_of_2 r) noexcept;
 
-constexpr power_of_2 operator*(power_of_2 l, power_of_2 r) noexcept;
-constexpr fraction operator*(power_of_2 l, fraction const& r) noexcept;
-constexpr fraction operator*(fraction const& l, power_of_2 r) noexcept;
+namespace detail {
 
-constexpr power_of_2 operator/(power_of_2 l, power_of_2 r) noexcept;
-constexpr fraction operator/(power_of_2 l, fraction const& r) noexcept;
-constexpr fraction operator/(fraction const& l, power_of_2 r) noexcept;
+// TODO: use <bit> for all of this in C++20
 
-constexpr fraction operator%(power_of_2 l, power_of_2 r) noexcept;
-constexpr fraction operator%(power_of_2 l, fraction const& r) noexcept;
-constexpr fraction operator%(fraction const& l, power_of_2 r) noexcept;
+// The magnitude as the unsigned type, which also holds that of the minimum
+template <typename Rep>
+constexpr std::make_unsigned_t<Rep> magnitude(Rep const value) noexcept
+{
+  using unsigned_t = std::make_unsigned_t<Rep>;
 
-constexpr power_of_2& operator*=(power_of_2& l, power_of_2 r) noexcept;
-constexpr power_of_2& operator/=(power_of_2& l, power_of_2 r) noexcept;
+  return (value < 0) ? unsigned_t(0) - static_cast<unsigned_t>(value)
+                     : static_cast<unsigned_t>(value);
+}
 
+// n / d is 2^e exactly when n = 2^a m and d = 2^b m for the same odd m, in
+// which case e = a - b. So neither a reduce nor a scan of the bits is needed.
+template <typename Rep>
+constexpr std::optional<int>
+power_of_2_exponent(basic_fraction<Rep> const& value) noexcept
+{
+  auto const numerator = value.numerator();
+  auto const denominator = value.denominator();
 
-// =================================================================================================
+  if (numerator == 0 || denominator == 0
+      || (numerator < 0) != (denominator < 0))
+    return std::nullopt;
 
+  auto const num_magnitude = magnitude(numerator);
+  auto const den_magnitude = magnitude(denominator);
 
-namespace detail {
+  auto const num_twos = count_trailing_zeros(num_magnitude);
+  auto const den_twos = count_trailing_zeros(den_magnitude);
 
-// TODO: use <bit> for all of this in C++20
+  if ((num_magnitude >> num_twos) != (den_magnitude >> den_twos))
+    return std::nullopt;
 
-using bitset_t = std::bitset<sizeof(fraction_rep_t) * CHAR_BIT - 1>;
+  return num_twos - den_twos;
+}
 
-constexpr int assert_is_power_of_2(bitset_t const bitset)
+// value * 2^shift, which must not exceed limit
+template <typename Rep>
+constexpr std::make_unsigned_t<Rep>
+checked_shift_left(std::make_unsigned_t<Rep> const value,
+                   long long const shift,
+                   std::make_unsigned_t<Rep> const limit)
 {
-  auto count = 0;
+  using unsigned_t = std::make_unsigned_t<Rep>;
 
-  for (std::size_t i = 0; i < bitset.size() && count < 2; ++i)
-    if (bitset[i])
-      ++count;
+  if (shift >= std::numeric_limits<unsigned_t>::digits
+      || value > (limit >> shift))
+    throw std::overflow_error("the scaled fraction does not fit in its rep");
 
-  return (count != 1) ? throw std::invalid_argument("not a power of 2")
-                      : int {};
+  return static_cast<unsigned_t>(value << shift);
 }
 
-constexpr int sqrt_of_2(fraction_rep_t const value)
+// f * 2^exponent, cancelling factors of 2 between the shifted term and the
+// other one so that a reduced fraction stays reduced. The exponent is a long
+// long so that callers can negate any int exponent.
+template <typename Rep>
+constexpr basic_fraction<Rep> scale_by_power_of_2(basic_fraction<Rep> const& f,
+                                                  long long const exponent)
 {
-  auto const bitset = bitset_t(value);
+  using unsigned_t = std::make_unsigned_t<Rep>;
 
-  assert_is_power_of_2(bitset);
+  auto const numerator = f.numerator();
+  auto const denominator = f.denominator();
 
-  auto result = 0;
+  if (numerator == 0 || denominator == 0 || exponent == 0)
+    return f;
 
-  while (!bitset[result])
-    ++result;
+  auto const is_negative = (numerator < 0) != (denominator < 0);
 
-  return result;
-}
+  // The numerator takes the sign, so a negative one can reach Rep's minimum
+  auto const max = static_cast<unsigned_t>(std::numeric_limits<Rep>::max());
+  auto const num_limit = is_negative ? static_cast<unsigned_t>(max + 1) : max;
 
-constexpr int sqrt_of_2(fraction const value)
-{
-  auto const reduced_value = reduce(value);
+  auto num_magnitude = magnitude(numerator);
+  auto den_magnitude = magnitude(denominator);
 
-  if (is_positive(reduced_value))
+  if (exponent > 0)
   {
-    if (is_integer(reduced_value))
-      return sqrt_of_2(reduced_value.numerator());
+    auto const twos
+      = static_cast<long long>(count_trailing_zeros(den_magnitude));
+    auto const cancelled = (twos < exponent) ? twos : exponent;
 
-    if (is_unit_fraction(reduced_value))
-      return -sqrt_of_2(reduced_value.denominator());
+    den_magnitude >>= cancelled;
+    num_magnitude = checked_shift_left<Rep>(
+      num_magnitude, exponent - cancelled, num_limit);
   }
+  else
+  {
+    auto const twos
+      = static_cast<long long>(count_trailing_zeros(num_magnitude));
+    auto const cancelled = (twos < -exponent) ? twos : -exponent;
+
+    num_magnitude >>= cancelled;
+    den_magnitude
+      = checked_shift_left<Rep>(den_magnitude, -exponent - cancelled, max);
+  }
+
+  if (num_magnitude > num_limit || den_magnitude > max)
+    throw std::overflow_error("the scaled fraction does not fit in its rep");
 
-  return true
+  // Negated in two steps, as the magnitude of Rep's minimum is not a Rep
+  auto const signed_numerator
+    = is_negative ? static_cast<Rep>(-static_cast<Rep>(num_magnitude - 1) - 1)
+                  : static_cast<Rep>(num_magnitude);
+
+  return basic_fraction<Rep>(signed_numerator, static_cast<Rep>(den_magnitude));
+}
+
+template <typename Rep>
+constexpr int checked_power_of_2_exponent(basic_fraction<Rep> const& value)
+{
+  auto const exponent = power_of_2_exponent(value);
+
+  return !exponent
            ? throw std::invalid_argument("a power of two must be a positive "
                                          "integer or a positive unit fraction")
-           : int {};
+           : *exponent;
 }
 } // namespace detail
 
-constexpr power_of_2::power_of_2(fraction const value) :
-  power_of_2 {from_exponent, detail::sqrt_of_2(value)}
+template <typename Rep>
+constexpr basic_power_of_2<Rep>::basic_power_of_2(fraction_type const value) :
+  basic_power_of_2 {from_exponent, detail::checked_power_of_2_exponent(value)}
 {
 }
 
-constexpr power_of_2::power_of_2(from_exponent_t, int const exponent) noexcept :
+template <typename Rep>
+constexpr basic_power_of_2<Rep>::basic_power_of_2(from_exponent_t,
+                                                  int const exponent) noexcept :
   exponent_ {exponent}
 {
 }
 
-constexpr fraction power_of_2::get_value() const noexcept
+template <typename Rep>
+constexpr basic_fraction<Rep> basic_power_of_2<Rep>::get_value() const noexcept
 {
-  return ieme::pow2<fraction_rep_t, fraction_ops_t>(exponent_);
+  return ieme::pow2<Rep, fraction_ops_t>(exponent_);
+}
+
+template <typename Rep>
+constexpr std::optional<basic_power_of_2<Rep>>
+try_make_power_of_2(basic_fraction<Rep> const& value) noexcept
+{
+  auto const exponent = detail::power_of_2_exponent(value);
+
+  if (!exponent)
+    return std::nullopt;
+
+  return basic_power_of_2<Rep>(basic_power_of_2<Rep>::from_exponent, *exponent);
 }
 
-constexpr bool operator==(power_of_2 const l, power_of_2 const r) noexcept
+template <typename Rep>
+constexpr bool operator==(basic_power_of_2<Rep> const l,
+                          basic_power_of_2<Rep> const r) noexcept
 {
-  return l.exponent_ == r.exponent_;
+  return l.get_exponent() == r.get_exponent();
 }
 
-constexpr bool operator==(power_of_2 const l, fraction const& r) noexcept
+template <typename Rep>
+constexpr bool operator==(basic_power_of_2<Rep> const l,
+                          detail::fraction_of_t<Rep> const& r) noexcept
 {
   return l.get_value() == r;
 }
 
-constexpr bool operator==(fraction const& l, power_of_2 const r) noexcept
+template <typename Rep>
+constexpr bool operator==(detail::fraction_of_t<Rep> const& l,
+                          basic_power_of_2<Rep> const r) noexcept
 {
   return r == l;
 }
 
-constexpr bool operator!=(power_of_2 const l, power_of_2 const r) noexcept
+template <typename Rep>
+constexpr bool operator!=(basic_power_of_2<Rep> const l,
+                          basic_power_of_2<Rep> const r) noexcept
 {
   return !(l == r);
 }
 
-constexpr bool operator!=(power_of_2 const l, fraction const& r) noexcept
+template <typename Rep>
+constexpr bool operator!=(basic_power_of_2<Rep> const l,
+                          detail::fraction_of_t<Rep> const& r) noexcept
 {
   return !(l == r);
 }
 
-constexpr bool operator!=(fraction const& l, power_of_2 const r) noexcept
+template <typename Rep>
+constexpr bool operator!=(detail::fraction_of_t<Rep> const& l,
+                          basic_power_of_2<Rep> const r) noexcept
 {
   return r != l;
 }
 
-constexpr bool operator<(power_of_2 const l, power_of_2 const r) noexcept
+template <typename Rep>
+constexpr bool operator<(basic_power_of_2<Rep> const l,
+                         basic_power_of_2<Rep> const r) noexcept
 {
-  return l.exponent_ < r.exponent_;
+  return l.get_exponent() < r.get_exponent();
 }
 
-constexpr bool operator<(power_of_2 const l, fraction const& r) noexcept
+template <typename Rep>
+constexpr bool operator<(basic_power_of_2<Rep> const l,
+                         detail::fraction_of_t<Rep> const& r) noexcept
 {
   return l.get_value() < r;
 }
 
-constexpr bool operator<(fraction const& l, power_of_2 const r) noexcept
+template <typename Rep>
+constexpr bool operator<(detail::fraction_of_t<Rep> const& l,
+                         basic_power_of_2<Rep> const r) noexcept
 {
   return l < r.get_value();
 }
 
-constexpr bool operator<=(power_of_2 const l, power_of_2 const r) noexcept
+template <typename Rep>
+constexpr bool operator<=(basic_power_of_2<Rep> const l,
+                          basic_power_of_2<Rep> const r) noexcept
 {
   return !(l > r);
 }
 
-constexpr bool operator<=(power_of_2 const l, fraction const& r) noexcept
+template <typename Rep>
+constexpr bool operator<=(basic_power_of_2<Rep> const l,
+                          detail::fraction_of_t<Rep> const& r) noexcept
 {
   return !(l > r);
 }
 
-constexpr bool operator<=(fraction const& l, power_of_2 const r) noexcept
+template <typename Rep>
+constexpr bool operator<=(detail::fraction_of_t<Rep> const& l,
+                          basic_power_of_2<Rep> const r) noexcept
 {
   return !(l > r);
 }
 
-constexpr bool operator>(power_of_2 const l, power_of_2 const r) noexcept
+template <typename Rep>
+constexpr bool operator>(basic_power_of_2<Rep> const l,
+                         basic_power_of_2<Rep> const r) noexcept
 {
   return r < l;
 }
 
-constexpr bool operator>(power_of_2 const l, fraction const& r) noexcept
+template <typename Rep>
+constexpr bool operator>(basic_power_of_2<Rep> const l,
+                         detail::fraction_of_t<Rep> const& r) noexcept
 {
   return r < l;
 }
 
-constexpr bool operator>(fraction const& l, power_of_2 const r) noexcept
+template <typename Rep>
+constexpr bool operator>(detail::fraction_of_t<Rep> const& l,
+                         basic_power_of_2<Rep> const r) noexcept
 {
   return r < l;
 }
 
-constexpr bool operator>=(power_of_2 const l, power_of_2 const r) noexcept
+template <typename Rep>
+constexpr bool operator>=(basic_power_of_2<Rep> const l,
+                          basic_power_of_2<Rep> const r) noexcept
 {
   return !(l < r);
 }
 
-constexpr bool operator>=(power_of_2 const l, fraction const& r) noexcept
+template <typename Rep>
+constexpr bool operator>=(basic_power_of_2<Rep> const l,
+                          detail::fraction_of_t<Rep> const& r) noexcept
 {
   return !(l < r);
 }
 
-constexpr bool operator>=(fraction const& l, power_of_2 const r) noexcept
+template <typename Rep>
+constexpr bool operator>=(detail::fraction_of_t<Rep> const& l,
+                          basic_power_of_2<Rep> const r) noexcept
 {
   return !(l < r);
 }
 
-constexpr power_of_2 operator+(power_of_2 const p) noexcept
+template <typename Rep>
+constexpr basic_power_of_2<Rep>
+operator+(basic_power_of_2<Rep> const p) noexcept
 {
   return p;
 }
 
-constexpr fraction operator-(power_of_2 const p) noexcept
+template <typename Rep>
+constexpr basic_fraction<Rep> operator-(basic_power_of_2<Rep> const p) noexcept
 {
   return -p.get_value();
 }
 
-constexpr fraction operator+(power_of_2 const l, power_of_2 const r) noexcept
+template <typename Rep>
+constexpr basic_fraction<Rep> operator+(basic_power_of_2<Rep> const l,
+                                        basic_power_of_2<Rep> const r) noexcept
 {
   return l + r.get_value();
 }
 
-constexpr fraction operator+(power_of_2 const l, fraction const& r) noexcept
+template <typename Rep>
+constexpr basic_fraction<Rep>
+operator+(basic_power_of_2<Rep> const l,
+          detail::fraction_of_t<Rep> const& r) noexcept
 {
   return l.get_value() + r;
 }
 
-constexpr fraction operator+(fraction const& l, power_of_2 const r) noexcept
+template <typename Rep>
+constexpr basic_fraction<Rep> operator+(detail::fraction_of_t<Rep> const& l,
+                                        basic_power_of_2<Rep> const r) noexcept
 {
   return r + l;
 }
 
-constexpr fraction operator-(power_of_2 const l, power_of_2 const r) noexcept
+template <typename Rep>
+constexpr basic_fraction<Rep> operator-(basic_power_of_2<Rep> const l,
+                                        basic_power_of_2<Rep> const r) noexcept
 {
   return l - r.get_value();
 }
 
-constexpr fraction operator-(power_of_2 const l, fraction const& r) noexcept
+template <typename Rep>
+constexpr basic_fraction<Rep>
+operator-(basic_power_of_2<Rep> const l,
+          detail::fraction_of_t<Rep> const& r) noexcept
 {
   return l.get_value() - r;
 }
 
-constexpr fraction operator-(fraction const& l, power_of_2 const r) noexcept
+template <typename Rep>
+constexpr basic_fraction<Rep> operator-(detail::fraction_of_t<Rep> const& l,
+                                        basic_power_of_2<Rep> const r) noexcept
 {
   return l - r.get_value();
 }
 
-constexpr power_of_2 operator*(power_of_2 const l, power_of_2 const r) noexcept
+template <typename Rep>
+constexpr basic_power_of_2<Rep>
+operator*(basic_power_of_2<Rep> const l, basic_power_of_2<Rep> const r) noexcept
 {
-  return power_of_2(power_of_2::from_exponent, l.exponent_ + r.exponent_);
+  return basic_power_of_2<Rep>(basic_power_of_2<Rep>::from_exponent,
+                               l.get_exponent() + r.get_exponent());
 }
 
-constexpr fraction operator*(power_of_2 const l, fraction const& r) noexcept
+template <typename Rep>
+constexpr basic_fraction<Rep>
+operator*(basic_power_of_2<Rep> const l,
+          detail::fraction_of_t<Rep> const& r)
 {
-  return l.get_value() * r;
+  return detail::scale_by_power_of_2(r, l.get_exponent());
 }
 
-constexpr fraction operator*(fraction const& l, power_of_2 const r) noexcept
+template <typename Rep>
+constexpr basic_fraction<Rep> operator*(detail::fraction_of_t<Rep> const& l,
+                                        basic_power_of_2<Rep> const r)
 {
   return r * l;
 }
 
-constexpr power_of_2 operator/(power_of_2 const l, power_of_2 const r) noexcept
+template <typename Rep>
+constexpr basic_power_of_2<Rep>
+operator/(basic_power_of_2<Rep> const l, basic_power_of_2<Rep> const r) noexcept
 {
-  return power_of_2(power_of_2::from_exponent, l.exponent_ - r.exponent_);
+  return basic_power_of_2<Rep>(basic_power_of_2<Rep>::from_exponent,
+                               l.get_exponent() - r.get_exponent());
 }
 
-constexpr fraction operator/(power_of_2 const l, fraction const& r) noexcept
+template <typename Rep>
+constexpr basic_fraction<Rep>
+operator/(basic_power_of_2<Rep> const l,
+          detail::fraction_of_t<Rep> const& r)
 {
-  return l.get_value() / r;
+  return detail::scale_by_power_of_2(
+    basic_fraction<Rep>(r.denominator(), r.numerator()), l.get_exponent());
 }
 
-constexpr fraction operator/(fraction const& l, power_of_2 const r) noexcept
+template <typename Rep>
+constexpr basic_fraction<Rep> operator/(detail::fraction_of_t<Rep> const& l,
+                                        basic_power_of_2<Rep> const r)
 {
-  return l / r.get_value();
+  return detail::scale_by_power_of_2(
+    l, -static_cast<long long>(r.get_exponent()));
 }
 
-constexpr fraction operator%(power_of_2 const l, power_of_2 const r) noexcept
+template <typename Rep>
+constexpr basic_fraction<Rep> operator%(basic_power_of_2<Rep> const l,
+                                        basic_power_of_2<Rep> const r) noexcept
 {
   return l % r.get_value();
 }
 
-constexpr fraction operator%(power_of_2 const l, fraction const& r) noexcept
+template <typename Rep>
+constexpr basic_fraction<Rep>
+operator%(basic_power_of_2<Rep> const l,
+          detail::fraction_of_t<Rep> const& r) noexcept
 {
   return l.get_value() % r;
 }
 
-constexpr fraction operator%(fraction const& l, power_of_2 const r) noexcept
+template <typename Rep>
+constexpr basic_fraction<Rep> operator%(detail::fraction_of_t<Rep> const& l,
+                                        basic_power_of_2<Rep> const r) noexcept
 {
   return l % r.get_value();
 }
 
-constexpr power_of_2& operator*=(power_of_2& l, power_of_2 r) noexcept
+template <typename Rep>
+constexpr basic_power_of_2<Rep>& operator*=(basic_power_of_2<Rep>& l,
+                                            basic_power_of_2<Rep> r) noexcept
 {
   return l = l * r;
 }
 
-constexpr power_of_2& operator/=(power_of_2& l, power_of_2 r) noexcept
+template <typename Rep>
+constexpr basic_power_of_2<Rep>& operator/=(basic_power_of_2<Rep>& l,
+                                            basic_power_of_2<Rep> r) noexcept
 {
   return l = l / r;
 }
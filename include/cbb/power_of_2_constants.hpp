@@ -6,24 +6,69 @@
 
 namespace cbb::numbers {
 
-static constexpr auto one_256th = power_of_2(fraction(1, 256));
-static constexpr auto one_128th = power_of_2(fraction(1, 128));
-static constexpr auto one_64th = power_of_2(fraction(1, 64));
-static constexpr auto one_32nd = power_of_2(fraction(1, 32));
-static constexpr auto one_16th = power_of_2(fraction(1, 16));
-static constexpr auto one_8th = power_of_2(fraction(1, 8));
-static constexpr auto one_4th = power_of_2(fraction(1, 4));
-static constexpr auto one_quarter = power_of_2(one_4th);
-static constexpr auto one_half = power_of_2(fraction(1, 2));
-static constexpr auto _1 = power_of_2(1);
-static constexpr auto _2 = power_of_2(2);
-static constexpr auto _4 = power_of_2(4);
-static constexpr auto _8 = power_of_2(8);
-static constexpr auto _16 = power_of_2(16);
-static constexpr auto _32 = power_of_2(32);
-static constexpr auto _64 = power_of_2(64);
-static constexpr auto _128 = power_of_2(128);
-static constexpr auto _256 = power_of_2(256);
+template <typename Rep>
+static constexpr auto one_256th_v
+  = basic_power_of_2<Rep>(basic_fraction<Rep>(1, 256));
+template <typename Rep>
+static constexpr auto one_128th_v
+  = basic_power_of_2<Rep>(basic_fraction<Rep>(1, 128));
+template <typename Rep>
+static constexpr auto one_64th_v
+  = basic_power_of_2<Rep>(basic_fraction<Rep>(1, 64));
+template <typename Rep>
+static constexpr auto one_32nd_v
+  = basic_power_of_2<Rep>(basic_fraction<Rep>(1, 32));
+template <typename Rep>
+static constexpr auto one_16th_v
+  = basic_power_of_2<Rep>(basic_fraction<Rep>(1, 16));
+template <typename Rep>
+static constexpr auto one_8th_v
+  = basic_power_of_2<Rep>(basic_fraction<Rep>(1, 8));
+template <typename Rep>
+static constexpr auto one_4th_v
+  = basic_power_of_2<Rep>(basic_fraction<Rep>(1, 4));
+template <typename Rep>
+static constexpr auto one_quarter_v = basic_power_of_2<Rep>(one_4th_v<Rep>);
+template <typename Rep>
+static constexpr auto one_half_v
+  = basic_power_of_2<Rep>(basic_fraction<Rep>(1, 2));
+template <typename Rep>
+static constexpr auto _1_v = basic_power_of_2<Rep>(basic_fraction<Rep>(1));
+template <typename Rep>
+static constexpr auto _2_v = basic_power_of_2<Rep>(basic_fraction<Rep>(2));
+template <typename Rep>
+static constexpr auto _4_v = basic_power_of_2<Rep>(basic_fraction<Rep>(4));
+template <typename Rep>
+static constexpr auto _8_v = basic_power_of_2<Rep>(basic_fraction<Rep>(8));
+template <typename Rep>
+static constexpr auto _16_v = basic_power_of_2<Rep>(basic_fraction<Rep>(16));
+template <typename Rep>
+static constexpr auto _32_v = basic_power_of_2<Rep>(basic_fraction<Rep>(32));
+template <typename Rep>
+static constexpr auto _64_v = basic_power_of_2<Rep>(basic_fraction<Rep>(64));
+template <typename Rep>
+static constexpr auto _128_v = basic_power_of_2<Rep>(basic_fraction<Rep>(128));
+template <typename Rep>
+static constexpr auto _256_v = basic_power_of_2<Rep>(basic_fraction<Rep>(256));
+
+static constexpr auto one_256th = one_256th_v<fraction_rep_t>;
+static constexpr auto one_128th = one_128th_v<fraction_rep_t>;
+static constexpr auto one_64th = one_64th_v<fraction_rep_t>;
+static constexpr auto one_32nd = one_32nd_v<fraction_rep_t>;
+static constexpr auto one_16th = one_16th_v<fraction_rep_t>;
+static constexpr auto one_8th = one_8th_v<fraction_rep_t>;
+static constexpr auto one_4th = one_4th_v<fraction_rep_t>;
+static constexpr auto one_quarter = one_quarter_v<fraction_rep_t>;
+static constexpr auto one_half = one_half_v<fraction_rep_t>;
+static constexpr auto _1 = _1_v<fraction_rep_t>;
+static constexpr auto _2 = _2_v<fraction_rep_t>;
+static constexpr auto _4 = _4_v<fraction_rep_t>;
+static constexpr auto _8 = _8_v<fraction_rep_t>;
+static constexpr auto _16 = _16_v<fraction_rep_t>;
+static constexpr auto _32 = _32_v<fraction_rep_t>;
+static constexpr auto _64 = _64_v<fraction_rep_t>;
+static constexpr auto _128 = _128_v<fraction_rep_t>;
+static constexpr auto _256 = _256_v<fraction_rep_t>;
 
 } // namespace cbb::numbers
 
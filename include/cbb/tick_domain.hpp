@@ -0,0 +1,237 @@
+#ifndef CBB_TICK_DOMAIN_HPP
+#define CBB_TICK_DOMAIN_HPP
+
+#include <cbb/note_value.hpp>
+
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <stdexcept>
+
+
+namespace cbb {
+
+
+using tick_t = std::int64_t;
+
+
+// A fixed number of integer ticks per unit value. Projecting a set of onsets
+// or durations into a domain in which each is a whole number of ticks makes
+// their comparisons, hashes and sums single integer operations.
+class tick_domain final {
+
+public:
+  constexpr tick_domain() noexcept = default;
+
+  // Throws std::invalid_argument if the resolution is not positive
+  explicit constexpr tick_domain(tick_t resolution);
+
+  constexpr tick_t get_resolution() const noexcept { return resolution_; }
+
+  // Throws std::invalid_argument if the fraction is not a whole number of
+  // ticks, or std::overflow_error if the ticks do not fit in tick_t
+  template <typename Rep, typename Ops>
+  constexpr tick_t to_ticks(ieme::fraction<Rep, Ops> const& f) const;
+
+  // The reduced fraction of the ticks. Throws std::overflow_error if a term
+  // does not fit in Rep.
+  template <typename Rep = fraction_rep_t, typename Ops = fraction_ops_t>
+  constexpr ieme::fraction<Rep, Ops> to_fraction(tick_t ticks) const;
+
+  template <typename InputIt, typename OutputIt>
+  constexpr OutputIt
+  to_ticks(InputIt first, InputIt last, OutputIt d_first) const;
+
+  template <typename Rep = fraction_rep_t,
+            typename Ops = fraction_ops_t,
+            typename InputIt,
+            typename OutputIt>
+  constexpr OutputIt
+  to_fractions(InputIt first, InputIt last, OutputIt d_first) const;
+
+private:
+  tick_t resolution_ = 1;
+};
+
+constexpr bool operator==(tick_domain l, tick_domain r) noexcept;
+constexpr bool operator!=(tick_domain l, tick_domain r) noexcept;
+
+// The coarsest domain in which both domains' ticks are whole numbers of ticks.
+// Throws std::overflow_error if its resolution does not fit in tick_t.
+constexpr tick_domain common_tick_domain(tick_domain l, tick_domain r);
+
+// The coarsest domain in which every fraction is a whole number of ticks, i.e.
+// the one whose resolution is the least common multiple of the reduced
+// denominators. Throws std::overflow_error if it does not fit in tick_t.
+template <typename InputIt>
+constexpr tick_domain common_tick_domain(InputIt first, InputIt last);
+
+// The coarsest domain in which the relative value of every note value is a
+// whole number of ticks
+template <typename InputIt>
+constexpr tick_domain note_value_tick_domain(InputIt first, InputIt last);
+
+
+// =============================================================================
+
+
+namespace detail {
+
+constexpr tick_t checked_tick_product(tick_t const l, tick_t const r)
+{
+  constexpr auto max = std::numeric_limits<tick_t>::max();
+
+  auto const magnitude_l = (l < 0) ? -l : l;
+  auto const magnitude_r = (r < 0) ? -r : r;
+
+  if (magnitude_r != 0 && magnitude_l > max / magnitude_r)
+    throw std::overflow_error("the ticks do not fit in tick_t");
+
+  return l * r;
+}
+
+template <typename Rep>
+constexpr Rep checked_narrow(tick_t const value)
+{
+  if (value > std::numeric_limits<Rep>::max()
+      || value < std::numeric_limits<Rep>::min())
+    throw std::overflow_error("the ticks do not fit in a fraction");
+
+  return static_cast<Rep>(value);
+}
+
+// The reduced denominator of the relative value, built from the reduced tuplet
+// factor and dot augmentation so that only the power of 2 can grow it
+template <typename Rep>
+constexpr tick_t relative_value_denominator(basic_note_value<Rep> const& nv)
+{
+  auto const factor = binary_reduce(tuplet_factor<Rep>(nv.get_tuplet())
+                                    * dot_augmentation<Rep>(nv.get_num_dots()));
+  auto const exponent = nv.get_power_of_2().get_exponent();
+
+  // The denominator of the factor is far below 2^62, so clamping the scale
+  // cannot change their gcd
+  if (exponent >= 0)
+  {
+    auto const scale = tick_t(1) << (exponent < 62 ? exponent : 62);
+
+    return factor.denominator() / std::gcd(tick_t(factor.denominator()), scale);
+  }
+
+  if (-exponent >= std::numeric_limits<tick_t>::digits)
+    throw std::overflow_error("the ticks do not fit in tick_t");
+
+  auto const scale = tick_t(1) << -exponent;
+  auto const gcd = std::gcd(tick_t(factor.numerator()), scale);
+
+  return checked_tick_product(factor.denominator(), scale / gcd);
+}
+
+} // namespace detail
+
+constexpr tick_domain::tick_domain(tick_t const resolution) :
+  resolution_ {resolution}
+{
+  if (resolution <= 0)
+    throw std::invalid_argument("a tick resolution must be positive");
+}
+
+template <typename Rep, typename Ops>
+constexpr tick_t
+tick_domain::to_ticks(ieme::fraction<Rep, Ops> const& f) const
+{
+  auto const reduced = binary_reduce(f);
+  auto const denominator = static_cast<tick_t>(reduced.denominator());
+
+  if (denominator == 0 || resolution_ % denominator != 0)
+    throw std::invalid_argument("the fraction is not a whole number of ticks");
+
+  return detail::checked_tick_product(reduced.numerator(),
+                                      resolution_ / denominator);
+}
+
+template <typename Rep, typename Ops>
+constexpr ieme::fraction<Rep, Ops>
+tick_domain::to_fraction(tick_t const ticks) const
+{
+  auto const gcd = std::gcd(ticks, resolution_);
+
+  return {detail::checked_narrow<Rep>(ticks / gcd),
+          detail::checked_narrow<Rep>(resolution_ / gcd)};
+}
+
+template <typename InputIt, typename OutputIt>
+constexpr OutputIt
+tick_domain::to_ticks(InputIt first, InputIt last, OutputIt d_first) const
+{
+  for (; first != last; ++first, ++d_first)
+    *d_first = to_ticks(*first);
+
+  return d_first;
+}
+
+template <typename Rep, typename Ops, typename InputIt, typename OutputIt>
+constexpr OutputIt
+tick_domain::to_fractions(InputIt first, InputIt last, OutputIt d_first) const
+{
+  for (; first != last; ++first, ++d_first)
+    *d_first = to_fraction<Rep, Ops>(*first);
+
+  return d_first;
+}
+
+constexpr bool operator==(tick_domain const l, tick_domain const r) noexcept
+{
+  return l.get_resolution() == r.get_resolution();
+}
+
+constexpr bool operator!=(tick_domain const l, tick_domain const r) noexcept
+{
+  return !(l == r);
+}
+
+constexpr tick_domain common_tick_domain(tick_domain const l,
+                                         tick_domain const r)
+{
+  auto const gcd = std::gcd(l.get_resolution(), r.get_resolution());
+
+  return tick_domain(
+    detail::checked_tick_product(l.get_resolution() / gcd, r.get_resolution()));
+}
+
+template <typename InputIt>
+constexpr tick_domain common_tick_domain(InputIt first, InputIt const last)
+{
+  auto result = tick_domain();
+
+  for (; first != last; ++first)
+  {
+    auto const denominator = binary_reduce(*first).denominator();
+
+    if (denominator == 0)
+      throw std::invalid_argument("a fraction with a zero denominator has no "
+                                  "ticks");
+
+    result = common_tick_domain(result, tick_domain(denominator));
+  }
+
+  return result;
+}
+
+template <typename InputIt>
+constexpr tick_domain note_value_tick_domain(InputIt first, InputIt const last)
+{
+  auto result = tick_domain();
+
+  for (; first != last; ++first)
+    result = common_tick_domain(
+      result, tick_domain(detail::relative_value_denominator(*first)));
+
+  return result;
+}
+
+
+} // namespace cbb
+
+
+#endif
@@ -0,0 +1,181 @@
+#ifndef CBB_TIED_NOTE_VALUES_HPP
+#define CBB_TIED_NOTE_VALUES_HPP
+
+#include <cbb/tick_domain.hpp>
+
+#include <cstdint>
+#include <iterator>
+#include <stdexcept>
+#include <vector>
+
+
+namespace cbb {
+
+
+// Where a duration falls in the metre. When beat is positive, the duration is
+// first split at every multiple of beat after onset, so that no tied note
+// value crosses a beat.
+struct tie_context {
+  dot_count max_dots = dot_count::triple;
+  fraction onset = fraction(0);
+  fraction beat = fraction(0);
+};
+
+// Writes the note values that, tied together, last the given positive
+// duration, in chronological order and the largest first within each beat.
+// Each is the largest that fits what remains, so the ties are the greedy form
+// that notation uses rather than the fewest possible: 21/16 is a whole,
+// quarter and 16th note, not a triple-dotted half and a dotted quarter.
+// The note values for a duration, or for each piece of it between beats,
+// share the one tuplet whose note values can sum to it: a duplet for a
+// reduced denominator of 2^k, and a triplet, quintuplet, septuplet or
+// nonuplet for 3, 5, 7 or 9 times 2^k. Throws std::invalid_argument if the
+// duration is not positive or no tuplet fits its denominator or that of a
+// piece, and std::overflow_error if the onset, duration and beat have no
+// common tick_domain.
+template <typename OutputIt>
+OutputIt tied_note_values(fraction const& duration,
+                          OutputIt d_first,
+                          tie_context const& context = tie_context());
+
+inline std::vector<note_value>
+tied_note_values(fraction const& duration,
+                 tie_context const& context = tie_context());
+
+
+// =============================================================================
+
+
+namespace detail {
+
+inline int highest_set_bit(std::uint64_t const value) noexcept
+{
+#if defined(__GNUC__)
+  return 63 - __builtin_clzll(value);
+#else
+  auto result = 0;
+
+  for (auto remaining = value >> 1; remaining != 0; remaining >>= 1)
+    ++result;
+
+  return result;
+#endif
+}
+
+inline tuplet tuplet_for_odd_denominator(std::int64_t const odd_part)
+{
+  switch (odd_part)
+  {
+    case 1: return tuplet::duplet;
+    case 3: return tuplet::triplet;
+    case 5: return tuplet::quintuplet;
+    case 7: return tuplet::septuplet;
+    case 9: return tuplet::nonuplet;
+    default:
+      throw std::invalid_argument("no tuplet fits the denominator of the "
+                                  "duration");
+  }
+}
+
+// Scaled by half the tuplet count, the relative value of a note value with e
+// as its exponent and n dots is 2^(e - n) (2^(n + 1) - 1): a run of n + 1 one
+// bits whose highest is bit e. So the duration scaled the same way is written
+// as one note value per run of at most max_dots + 1 one bits, highest first.
+template <typename OutputIt>
+OutputIt append_tied_note_values(std::int64_t const numerator,
+                                 std::int64_t const denominator,
+                                 dot_count const max_dots,
+                                 OutputIt d_first)
+{
+  if (numerator <= 0 || denominator <= 0)
+    throw std::invalid_argument("only a positive duration has tied note "
+                                "values");
+
+  auto const gcd = binary_gcd(numerator, denominator);
+  auto const reduced_denominator = denominator / gcd;
+  auto const twos = count_trailing_zeros(reduced_denominator);
+  auto const t = tuplet_for_odd_denominator(reduced_denominator >> twos);
+
+  // The scaled duration is bits * 2^shift
+  auto bits = static_cast<std::uint64_t>(numerator / gcd);
+  auto const shift = -twos - (t == tuplet::duplet ? 0 : 1);
+  auto const max_run = to_underlying(max_dots) + 1;
+
+  while (bits != 0)
+  {
+    auto const highest = highest_set_bit(bits);
+    auto run = 1;
+
+    while (run < max_run && run <= highest
+           && ((bits >> (highest - run)) & 1) != 0)
+      ++run;
+
+    bits &= ~(((std::uint64_t(1) << run) - 1) << (highest + 1 - run));
+
+    auto const exponent = highest + shift;
+
+    *d_first = note_value(power_of_2(power_of_2::from_exponent, exponent),
+                          t,
+                          static_cast<dot_count>(run - 1));
+    ++d_first;
+  }
+
+  return d_first;
+}
+
+} // namespace detail
+
+template <typename OutputIt>
+OutputIt tied_note_values(fraction const& duration,
+                          OutputIt d_first,
+                          tie_context const& context)
+{
+  if (!(context.beat > 0))
+  {
+    auto const reduced = binary_reduce(duration);
+
+    return detail::append_tied_note_values(
+      reduced.numerator(), reduced.denominator(), context.max_dots, d_first);
+  }
+
+  fraction const terms[] = {context.onset, duration, context.beat};
+  auto const domain = common_tick_domain(std::begin(terms), std::end(terms));
+  auto const resolution = domain.get_resolution();
+
+  auto onset = domain.to_ticks(context.onset);
+  auto const end = onset + domain.to_ticks(duration);
+  auto const beat = domain.to_ticks(context.beat);
+
+  if (end <= onset)
+    throw std::invalid_argument("only a positive duration has tied note "
+                                "values");
+
+  while (onset < end)
+  {
+    auto const beat_offset = ((onset % beat) + beat) % beat;
+    auto const next_beat = onset - beat_offset + beat;
+    auto const piece_end = (next_beat < end) ? next_beat : end;
+
+    d_first = detail::append_tied_note_values(
+      piece_end - onset, resolution, context.max_dots, d_first);
+    onset = piece_end;
+  }
+
+  return d_first;
+}
+
+inline std::vector<note_value> tied_note_values(fraction const& duration,
+                                                tie_context const& context)
+{
+  auto result = std::vector<note_value>();
+
+  tied_note_values(duration, std::back_inserter(result), context);
+
+  return result;
+}
+
+
+} // namespace cbb
+
+
+#endif
@@ -0,0 +1,248 @@
+#define CATCH_CONFIG_MAIN
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include <catch2/catch.hpp>
+
+#include <Cbb/Fraction.hpp>
+#include <Cbb/NoteValue.hpp>
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <numeric>
+#include <string>
+#include <vector>
+
+
+using namespace Cbb;
+
+
+namespace {
+
+
+// A repeating mix of dotted and tuplet durations as found in a typical part
+std::vector<Fraction> makeDurations(const std::size_t size)
+{
+    const auto pattern = {relativeValue(NoteValue(eighthNote, 1)),
+                          relativeValue(NoteValue(sixteenthNote)),
+                          relativeValue(NoteValue(eighthNote, triplet)),
+                          relativeValue(NoteValue(sixteenthNote, quintuplet)),
+                          relativeValue(NoteValue(quarterNote, septuplet, 2)),
+                          relativeValue(NoteValue(thirtySecondNote, sextuplet, 1))};
+
+    auto durations = std::vector<Fraction>();
+    durations.reserve(size);
+
+    while (durations.size() < size)
+        for (const auto& duration : pattern)
+            durations.push_back(duration);
+
+    durations.resize(size);
+
+    return durations;
+}
+
+// Products of powers of two and small odd tuplet factors, as found in duration denominators
+std::vector<Fraction> makeUnreducedDurations(const std::size_t size)
+{
+    constexpr long long tupletFactors[] = {1, 3, 5, 7, 9, 15};
+
+    auto durations = std::vector<Fraction>();
+    durations.reserve(size);
+
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        const auto factor = tupletFactors[i % std::size(tupletFactors)];
+        const auto numerator = (1LL << (i % 5)) * tupletFactors[(i / 7) % std::size(tupletFactors)];
+        const auto denominator = (1LL << (i % 11)) * factor;
+
+        durations.emplace_back(numerator, denominator);
+    }
+
+    return durations;
+}
+
+Fraction expectedTotal(const std::vector<Fraction>& durations)
+{
+    // Reducing after every term is slow but never overflows for these durations
+    auto total = Fraction();
+
+    for (const auto& duration : durations)
+        total = reduce(total + duration);
+
+    return total;
+}
+
+// Writes whitespace separated "n/d" tokens until the file reaches the given size, as in a text dump
+// of a score's onsets and durations
+std::filesystem::path writeFractionDump(const std::size_t size)
+{
+    const auto path = std::filesystem::temp_directory_path() / "CbbFractionDump.txt";
+    const auto durations = makeUnreducedDurations(4096);
+
+    auto file = std::ofstream(path, std::ios::binary);
+    auto written = std::size_t(0);
+    auto index = std::size_t(0);
+
+    while (written < size)
+    {
+        const auto& duration = durations[index++ % durations.size()];
+        const auto onset = static_cast<long long>(index);
+
+        char buffer[2 * maxFractionChars + 2];
+        auto end = toChars(std::begin(buffer), std::end(buffer), Fraction(onset, 8)).ptr;
+        *end++ = ' ';
+        end = toChars(end, std::end(buffer), duration).ptr;
+        *end++ = '\n';
+
+        file.write(buffer, end - buffer);
+        written += static_cast<std::size_t>(end - buffer);
+    }
+
+    return path;
+}
+
+std::string readFile(const std::filesystem::path& path)
+{
+    auto file = std::ifstream(path, std::ios::binary);
+    auto contents = std::string(std::filesystem::file_size(path), '\0');
+
+    file.read(contents.data(), static_cast<std::streamsize>(contents.size()));
+
+    return contents;
+}
+
+bool isSpace(const char character)
+{
+    return character == ' ' || character == '\n' || character == '\t' || character == '\r';
+}
+
+
+} // namespace
+
+
+TEST_CASE("Summing 10^6 tuplet and dotted durations", "[Fraction][benchmark]")
+{
+    const auto durations = makeDurations(1'000'000);
+    const auto expected = expectedTotal(durations);
+
+    auto accumulator = FractionAccumulator();
+    for (const auto& duration : durations)
+        accumulator += duration;
+
+    CHECK(accumulator.total() == expected);
+
+    BENCHMARK("operator+ with reduce after every term")
+    {
+        auto total = Fraction();
+
+        for (const auto& duration : durations)
+            total = reduce(total + duration);
+
+        return total;
+    };
+
+    BENCHMARK("boundedSum")
+    {
+        auto total = Fraction();
+
+        for (const auto& duration : durations)
+            total = boundedSum(total, duration);
+
+        return total;
+    };
+
+    BENCHMARK("FractionAccumulator")
+    {
+        auto accumulator = FractionAccumulator();
+
+        for (const auto& duration : durations)
+            accumulator += duration;
+
+        return accumulator.total();
+    };
+}
+
+TEST_CASE("Reducing 10^6 duration fractions", "[Fraction][benchmark]")
+{
+    const auto durations = makeUnreducedDurations(1'000'000);
+
+    for (const auto& duration : durations)
+        CHECK(binaryGcd(duration.numerator(), duration.denominator())
+              == std::gcd(duration.numerator(), duration.denominator()));
+
+    BENCHMARK("std::gcd")
+    {
+        auto checksum = 0LL;
+
+        for (const auto& duration : durations)
+            checksum += std::gcd(duration.numerator(), duration.denominator());
+
+        return checksum;
+    };
+
+    BENCHMARK("binaryGcd")
+    {
+        auto checksum = 0LL;
+
+        for (const auto& duration : durations)
+            checksum += binaryGcd(duration.numerator(), duration.denominator());
+
+        return checksum;
+    };
+
+    BENCHMARK("reduce")
+    {
+        auto checksum = 0LL;
+
+        for (const auto& duration : durations)
+            checksum += reduce(duration).denominator();
+
+        return checksum;
+    };
+}
+
+TEST_CASE("Parsing a 100 MB text dump of fractions", "[Fraction][benchmark]")
+{
+    const auto path = writeFractionDump(100'000'000);
+
+    BENCHMARK("std::ifstream and operator>>")
+    {
+        auto file = std::ifstream(path, std::ios::binary);
+        auto checksum = 0LL;
+
+        for (auto fraction = Fraction(); file >> fraction;)
+            checksum += fraction.denominator();
+
+        return checksum;
+    };
+
+    BENCHMARK("read the file and tokenize with fromChars")
+    {
+        const auto contents = readFile(path);
+        const auto last = contents.data() + contents.size();
+        auto checksum = 0LL;
+
+        for (auto first = contents.data(); first != last;)
+        {
+            if (isSpace(*first))
+            {
+                ++first;
+                continue;
+            }
+
+            auto fraction = Fraction();
+            const auto result = fromChars(first, last, fraction);
+
+            if (result.ec != std::errc {})
+                break;
+
+            checksum += fraction.denominator();
+            first = result.ptr;
+        }
+
+        return checksum;
+    };
+
+    std::filesystem::remove(path);
+}
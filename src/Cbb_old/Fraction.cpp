@@ -1,14 +1,35 @@
 #include <Cbb/Fraction.hpp>
 
+#include <iterator>
 #include <limits>
 
 
 namespace Cbb {
 
 
+namespace {
+
+
+std::to_chars_result writeChar(char* const first, char* const last, const char character) noexcept
+{
+    if (first == last)
+        return {last, std::errc::value_too_large};
+
+    *first = character;
+
+    return {first + 1, std::errc {}};
+}
+
+
+} // namespace
+
+
 std::ostream& operator<<(std::ostream& stream, const Fraction& fraction) noexcept
 {
-    stream << fraction.numerator_ << '/' << fraction.denominator_;
+    char buffer[maxFractionChars];
+
+    const auto result = toChars(std::begin(buffer), std::end(buffer), fraction);
+    stream.write(buffer, result.ptr - buffer);
 
     return stream;
 }
@@ -22,5 +43,150 @@ std::istream& operator>>(std::istream& stream, Fraction& fraction) noexcept
     return stream;
 }
 
+std::from_chars_result fromChars(const char* const first,
+                                 const char* const last,
+                                 Fraction& fraction) noexcept
+{
+    auto numerator = 0LL;
+
+    const auto numeratorResult = std::from_chars(first, last, numerator);
+
+    if (numeratorResult.ec != std::errc {})
+        return numeratorResult;
+
+    if (numeratorResult.ptr == last || *numeratorResult.ptr != '/')
+    {
+        fraction = Fraction(numerator);
+        return numeratorResult;
+    }
+
+    auto denominator = 1LL;
+
+    const auto denominatorResult = std::from_chars(numeratorResult.ptr + 1, last, denominator);
+
+    if (denominatorResult.ec == std::errc::invalid_argument)
+        return {first, std::errc::invalid_argument};
+
+    if (denominatorResult.ec != std::errc {})
+        return denominatorResult;
+
+    fraction = Fraction(numerator, denominator);
+
+    return denominatorResult;
+}
+
+std::from_chars_result fromChars(const std::string_view text, Fraction& fraction) noexcept
+{
+    return fromChars(text.data(), text.data() + text.size(), fraction);
+}
+
+std::to_chars_result toChars(char* const first, char* const last, const Fraction& fraction) noexcept
+{
+    const auto numeratorResult = std::to_chars(first, last, fraction.numerator());
+
+    if (numeratorResult.ec != std::errc {})
+        return numeratorResult;
+
+    const auto slashResult = writeChar(numeratorResult.ptr, last, '/');
+
+    if (slashResult.ec != std::errc {})
+        return slashResult;
+
+    return std::to_chars(slashResult.ptr, last, fraction.denominator());
+}
+
+std::from_chars_result fromChars(const char* const first,
+                                 const char* const last,
+                                 MixedFraction& mixedFraction) noexcept
+{
+    auto wholePart = 0LL;
+
+    const auto wholeResult = std::from_chars(first, last, wholePart);
+
+    if (wholeResult.ec != std::errc {})
+        return wholeResult;
+
+    if (wholeResult.ptr != last && *wholeResult.ptr == '/')
+    {
+        auto fraction = Fraction();
+
+        const auto fractionResult = fromChars(first, last, fraction);
+
+        if (fractionResult.ec == std::errc {})
+            mixedFraction = MixedFraction(fraction);
+
+        return fractionResult;
+    }
+
+    if (wholeResult.ptr != last && *wholeResult.ptr == ' ')
+    {
+        const auto fractionalFirst = wholeResult.ptr + 1;
+
+        // Only a term followed by a slash belongs to this mixed fraction; a lone integer is the
+        // next token
+        auto numerator = 0LL;
+
+        const auto numeratorResult = std::from_chars(fractionalFirst, last, numerator);
+
+        if (numeratorResult.ec == std::errc {} && numeratorResult.ptr != last
+            && *numeratorResult.ptr == '/')
+        {
+            auto fractionalPart = Fraction();
+
+            const auto fractionalResult = fromChars(fractionalFirst, last, fractionalPart);
+
+            if (fractionalResult.ec == std::errc::invalid_argument)
+                return {first, std::errc::invalid_argument};
+
+            // A zero whole part has no sign of its own, so "-0 1/3" is negated here
+            if (wholePart == 0 && *first == '-')
+                fractionalPart = -fractionalPart;
+
+            if (fractionalResult.ec == std::errc {})
+                mixedFraction = MixedFraction(wholePart, fractionalPart);
+
+            return fractionalResult;
+        }
+    }
+
+    mixedFraction = MixedFraction(wholePart, {});
+
+    return wholeResult;
+}
+
+std::from_chars_result fromChars(const std::string_view text, MixedFraction& mixedFraction) noexcept
+{
+    return fromChars(text.data(), text.data() + text.size(), mixedFraction);
+}
+
+std::to_chars_result toChars(char* const first,
+                             char* const last,
+                             const MixedFraction& mixedFraction) noexcept
+{
+    if (mixedFraction.wholePart() == 0 && !isZero(mixedFraction.fractionalPart()))
+    {
+        const auto fraction = mixedFraction.fractionalPart();
+
+        // The sign goes on the numerator, so that "-1/3" is written rather than "1/-3"
+        return toChars(first,
+                       last,
+                       (fraction.denominator() < 0)
+                           ? Fraction(-fraction.numerator(), -fraction.denominator())
+                           : fraction);
+    }
+
+    const auto wholeResult = std::to_chars(first, last, mixedFraction.wholePart());
+
+    if (wholeResult.ec != std::errc {} || isZero(mixedFraction.fractionalPart()))
+        return wholeResult;
+
+    const auto spaceResult = writeChar(wholeResult.ptr, last, ' ');
+
+    if (spaceResult.ec != std::errc {})
+        return spaceResult;
+
+    return toChars(spaceResult.ptr, last, mixedFraction.fractionalPart());
+}
+
 
 }; // namespace Cbb
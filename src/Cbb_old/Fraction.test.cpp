@@ -3,7 +3,10 @@
 
 #include <Cbb/Fraction.hpp>
 
+#include <iterator>
+#include <limits>
 #include <sstream>
+#include <string_view>
 
 
 using namespace Cbb;
@@ -164,6 +167,24 @@ TEST_CASE("A reducible fraction can be reduced", "[Fraction]")
     REQUIRE(symbolicallyEqual(reduce(Fraction(12, 32)), Fraction(3, 8)));
 }
 
+TEST_CASE("The greatest common divisor can be computed by the binary algorithm", "[Fraction]")
+{
+    REQUIRE(binaryGcd(0, 0) == 0);
+    REQUIRE(binaryGcd(0, 12) == 12);
+    REQUIRE(binaryGcd(-12, 0) == 12);
+    REQUIRE(binaryGcd(48, 80) == 16);
+    REQUIRE(binaryGcd(-96, 160) == 32);
+    REQUIRE(binaryGcd(7 * 64, 5 * 256) == 64);
+    REQUIRE(binaryGcd(17, 13) == 1);
+    REQUIRE(binaryGcd(1LL << 62, 3LL << 40) == 1LL << 40);
+}
+
+TEST_CASE("A negative reducible fraction can be reduced", "[Fraction]")
+{
+    REQUIRE(symbolicallyEqual(reduce(Fraction(-12, -32)), Fraction(3, 8)));
+    REQUIRE(symbolicallyEqual(reduce(Fraction(12, -32)), Fraction(3, -8)));
+}
+
 TEST_CASE("An already irreducible fraction can be reduced", "[Fraction]")
 {
     REQUIRE(symbolicallyEqual(reduce(Fraction(7, 9)), Fraction(7, 9)));
@@ -224,6 +245,9 @@ TEST_CASE("A fraction can be ceilinged")
     REQUIRE(ceil(Fraction(-7, 3)) == -2);
     REQUIRE(ceil(Fraction(-8, 3)) == -2);
     REQUIRE(ceil(Fraction(-2)) == -2);
+    REQUIRE(ceil(Fraction(1, 3)) == 1);
+    REQUIRE(ceil(Fraction(-1, 3)) == 0);
+    REQUIRE(ceil(Fraction(1, -3)) == 0);
 }
 
 TEST_CASE("A fraction can be floored")
@@ -234,6 +258,9 @@ TEST_CASE("A fraction can be floored")
     REQUIRE(floor(Fraction(-7, 3)) == -3);
     REQUIRE(floor(Fraction(-8, 3)) == -3);
     REQUIRE(floor(Fraction(-2)) == -2);
+    REQUIRE(floor(Fraction(1, 3)) == 0);
+    REQUIRE(floor(Fraction(-1, 3)) == -1);
+    REQUIRE(floor(Fraction(1, -3)) == -1);
 }
 
 TEST_CASE("A fraction can be truncated")
@@ -432,6 +459,202 @@ TEST_CASE("A fraction can be deserialized", "[Fraction]")
     REQUIRE(f == Fraction(-5, 7));
 }
 
+TEST_CASE("A fraction can be parsed from characters", "[Fraction]")
+{
+    auto f = Fraction();
+
+    SECTION("A numerator and denominator")
+    {
+        const auto text = std::string_view("-5/7 3/4");
+        const auto result = fromChars(text, f);
+
+        REQUIRE(result.ec == std::errc {});
+        REQUIRE(result.ptr == text.data() + 4);
+        REQUIRE(symbolicallyEqual(f, Fraction(-5, 7)));
+    }
+
+    SECTION("An integer")
+    {
+        const auto text = std::string_view("12 ");
+        const auto result = fromChars(text, f);
+
+        REQUIRE(result.ec == std::errc {});
+        REQUIRE(result.ptr == text.data() + 2);
+        REQUIRE(symbolicallyEqual(f, Fraction(12, 1)));
+    }
+
+    SECTION("A negative denominator")
+    {
+        REQUIRE(fromChars("3/-4", f).ec == std::errc {});
+        REQUIRE(symbolicallyEqual(f, Fraction(3, -4)));
+    }
+
+    SECTION("Text that does not start with a fraction")
+    {
+        const auto text = std::string_view(" 3/4");
+        const auto result = fromChars(text, f);
+
+        REQUIRE(result.ec == std::errc::invalid_argument);
+        REQUIRE(result.ptr == text.data());
+        REQUIRE(symbolicallyEqual(f, Fraction()));
+    }
+
+    SECTION("A slash without a denominator")
+    {
+        const auto text = std::string_view("3/x");
+        const auto result = fromChars(text, f);
+
+        REQUIRE(result.ec == std::errc::invalid_argument);
+        REQUIRE(result.ptr == text.data());
+        REQUIRE(symbolicallyEqual(f, Fraction()));
+    }
+
+    SECTION("A term that does not fit")
+    {
+        const auto text = std::string_view("1/99999999999999999999");
+        const auto result = fromChars(text, f);
+
+        REQUIRE(result.ec == std::errc::result_out_of_range);
+        REQUIRE(result.ptr == text.data() + text.size());
+        REQUIRE(symbolicallyEqual(f, Fraction()));
+    }
+}
+
+TEST_CASE("A fraction can be written to characters", "[Fraction]")
+{
+    char buffer[maxFractionChars];
+
+    SECTION("A fraction that fits")
+    {
+        const auto result = toChars(std::begin(buffer), std::end(buffer), Fraction(-5, 7));
+
+        REQUIRE(result.ec == std::errc {});
+        REQUIRE(std::string_view(buffer, result.ptr - buffer) == "-5/7");
+    }
+
+    SECTION("The longest fraction")
+    {
+        constexpr auto min = std::numeric_limits<long long>::min();
+
+        const auto result = toChars(std::begin(buffer), std::end(buffer), Fraction(min, min));
+
+        REQUIRE(result.ec == std::errc {});
+        REQUIRE(result.ptr == std::end(buffer));
+    }
+
+    SECTION("A buffer that is too small")
+    {
+        REQUIRE(toChars(buffer, buffer + 2, Fraction(-5, 7)).ec == std::errc::value_too_large);
+        REQUIRE(toChars(buffer, buffer + 3, Fraction(-5, 7)).ec == std::errc::value_too_large);
+    }
+
+    SECTION("Round trip")
+    {
+        const auto original = Fraction(123456789, -987654321);
+        const auto written = toChars(std::begin(buffer), std::end(buffer), original);
+
+        auto parsed = Fraction();
+        fromChars(std::string_view(buffer, written.ptr - buffer), parsed);
+
+        REQUIRE(symbolicallyEqual(parsed, original));
+    }
+}
+
+TEST_CASE("A mixed fraction can be parsed from characters", "[Fraction]")
+{
+    auto f = MixedFraction();
+
+    SECTION("A whole and fractional part")
+    {
+        const auto text = std::string_view("150 1/2");
+        const auto result = fromChars(text, f);
+
+        REQUIRE(result.ec == std::errc {});
+        REQUIRE(result.ptr == text.data() + text.size());
+        REQUIRE(f == MixedFraction(150, {1, 2}));
+    }
+
+    SECTION("A fraction")
+    {
+        REQUIRE(fromChars("-11/4", f).ec == std::errc {});
+        REQUIRE(f == MixedFraction(Fraction(-11, 4)));
+    }
+
+    SECTION("A whole part followed by another token")
+    {
+        const auto text = std::string_view("120 7");
+        const auto result = fromChars(text, f);
+
+        REQUIRE(result.ec == std::errc {});
+        REQUIRE(result.ptr == text.data() + 3);
+        REQUIRE(f == MixedFraction(120, {}));
+    }
+
+    SECTION("A zero whole part with a sign")
+    {
+        REQUIRE(fromChars("0 1/3", f).ec == std::errc {});
+        REQUIRE(symbolicallyEqual(f, Fraction(1, 3)));
+
+        REQUIRE(fromChars("0 -1/3", f).ec == std::errc {});
+        REQUIRE(symbolicallyEqual(f, Fraction(-1, 3)));
+
+        REQUIRE(fromChars("-0 1/3", f).ec == std::errc {});
+        REQUIRE(symbolicallyEqual(f, Fraction(-1, 3)));
+    }
+
+    SECTION("A fractional part without a denominator")
+    {
+        const auto text = std::string_view("120 7/");
+        const auto result = fromChars(text, f);
+
+        REQUIRE(result.ec == std::errc::invalid_argument);
+        REQUIRE(result.ptr == text.data());
+    }
+}
+
+TEST_CASE("A mixed fraction can be written to characters", "[Fraction]")
+{
+    char buffer[maxMixedFractionChars];
+
+    const auto write = [&](const MixedFraction& f) {
+        const auto result = toChars(std::begin(buffer), std::end(buffer), f);
+        REQUIRE(result.ec == std::errc {});
+        return std::string_view(buffer, result.ptr - buffer);
+    };
+
+    REQUIRE(write(MixedFraction(-5, {4, 5})) == "-5 4/5");
+    REQUIRE(write(MixedFraction(120, {})) == "120");
+    REQUIRE(write(MixedFraction(Fraction(1, 3))) == "1/3");
+    REQUIRE(write(MixedFraction(Fraction(-1, 3))) == "-1/3");
+    REQUIRE(write(MixedFraction(Fraction(1, -3))) == "-1/3");
+    REQUIRE(write(MixedFraction()) == "0");
+    REQUIRE(toChars(buffer, buffer + 4, MixedFraction(-5, {4, 5})).ec
+            == std::errc::value_too_large);
+}
+
+TEST_CASE("A mixed fraction keeps its value and sign when written and parsed", "[Fraction]")
+{
+    char buffer[maxMixedFractionChars];
+
+    for (const auto original : {Fraction(1, 3),
+                                Fraction(-1, 3),
+                                Fraction(0),
+                                Fraction(4, 3),
+                                Fraction(-4, 3)})
+    {
+        const auto written = toChars(std::begin(buffer), std::end(buffer), MixedFraction(original));
+
+        REQUIRE(written.ec == std::errc {});
+
+        auto parsed = MixedFraction();
+        const auto result = fromChars(std::string_view(buffer, written.ptr - buffer), parsed);
+
+        REQUIRE(result.ec == std::errc {});
+        REQUIRE(result.ptr == written.ptr);
+        REQUIRE(parsed == original);
+    }
+}
+
 TEST_CASE("A default-constructed unit fraction is 1", "[Fraction]")
 {
     constexpr auto f = UnitFraction();
@@ -471,9 +694,97 @@ TEST_CASE("A mixed fraction can constructed from a fraction", "[Fraction]")
     REQUIRE(symbolicallyEqual(f.fractionalPart(), Fraction(3, 4)));
 }
 
+TEST_CASE("A mixed fraction between -1 and 1 keeps its sign in its fractional part", "[Fraction]")
+{
+    constexpr auto f = MixedFraction(Fraction(-1, 3));
+
+    REQUIRE(f.wholePart() == 0);
+    REQUIRE(symbolicallyEqual(f.fractionalPart(), Fraction(-1, 3)));
+    REQUIRE(symbolicallyEqual(f.asFraction(), Fraction(-1, 3)));
+    REQUIRE(symbolicallyEqual(MixedFraction(Fraction(1, 3)).asFraction(), Fraction(1, 3)));
+}
+
 TEST_CASE("A mixed fraction can be converted to a fraction", "[Fraction]")
 {
     constexpr auto f = (Fraction) MixedFraction(-3, {1, 9});
 
     REQUIRE(symbolicallyEqual(f, {-28, 9}));
 }
+
+TEST_CASE("Fractions can be added over their least common denominator", "[Fraction]")
+{
+    REQUIRE(symbolicallyEqual(boundedSum(Fraction(1, 6), Fraction(1, 4)), Fraction(5, 12)));
+    REQUIRE(symbolicallyEqual(boundedSum(Fraction(1, -6), Fraction(1, 4)), Fraction(1, 12)));
+    REQUIRE(symbolicallyEqual(boundedDifference(Fraction(1, 6), Fraction(1, 4)), Fraction(-1, 12)));
+}
+
+TEST_CASE("A bounded sum reduces its result once it passes the reduction threshold", "[Fraction]")
+{
+    constexpr auto large = Fraction(fractionReductionThreshold, 3 * fractionReductionThreshold);
+
+    REQUIRE(symbolicallyEqual(boundedSum(large, Fraction(1, 3)), Fraction(2, 3)));
+}
+
+TEST_CASE("A bounded sum of undefined fractions is undefined", "[Fraction]")
+{
+    REQUIRE(isUndefined(boundedSum(Fraction(1, 0), Fraction(1, 4))));
+}
+
+TEST_CASE("A fraction accumulator can sum many fractions without overflowing", "[Fraction]")
+{
+    auto accumulator = FractionAccumulator();
+
+    for (auto i = 0; i < 1000; ++i)
+        accumulator += (i % 2 == 0) ? Fraction(1, 12) : Fraction(3, 40);
+
+    REQUIRE(symbolicallyEqual(accumulator.total(), Fraction(475, 6)));
+
+    accumulator -= Fraction(475, 6);
+
+    REQUIRE(isZero(accumulator.total()));
+}
+
+TEST_CASE("Fractions can be three-way compared", "[Fraction]")
+{
+    REQUIRE(compare(Fraction(2, 3), Fraction(4, 5)) < 0);
+    REQUIRE(compare(Fraction(8, 10), Fraction(4, 5)) == 0);
+    REQUIRE(compare(Fraction(4, 7), Fraction(2, 5)) > 0);
+    REQUIRE(compare(Fraction(1, -3), Fraction(-1, 3)) == 0);
+    REQUIRE(compare(Fraction(3, 16), Fraction(1, 4)) < 0);
+    REQUIRE(compare(Fraction(-5, 8), Fraction(-3, 4)) > 0);
+}
+
+TEST_CASE("Fractions with large terms can be compared without overflowing", "[Fraction]")
+{
+    constexpr auto max = std::numeric_limits<long long>::max();
+
+    REQUIRE(Fraction(max - 1, max) < Fraction(1));
+    REQUIRE(Fraction(max - 2, max - 1) < Fraction(max - 1, max));
+    REQUIRE(Fraction(max, 1) > Fraction(1, 1LL << 62));
+    REQUIRE(Fraction(-max, 2) < Fraction(1, 1LL << 62));
+    REQUIRE(Fraction(3 * (max / 3), max / 3) == Fraction(3));
+}
+
+TEST_CASE("Fractions can be compared by continued fraction expansion", "[Fraction]")
+{
+    constexpr auto max = std::numeric_limits<long long>::max();
+
+    REQUIRE(detail::compareByContinuedFraction({2, 3}, {3, 5}) > 0);
+    REQUIRE(detail::compareByContinuedFraction({3, 5}, {2, 3}) < 0);
+    REQUIRE(detail::compareByContinuedFraction({6, 9}, {2, 3}) == 0);
+    REQUIRE(detail::compareByContinuedFraction({-2, 3}, {-3, 5}) < 0);
+    REQUIRE(detail::compareByContinuedFraction({0, 3}, {-3, 5}) > 0);
+    REQUIRE(detail::compareByContinuedFraction({7, 1}, {43, 6}) < 0);
+    REQUIRE(detail::compareByContinuedFraction({max - 2, max - 1}, {max - 1, max}) < 0);
+}
+
+TEST_CASE("Fractions with power of two denominators can be compared by shifting", "[Fraction]")
+{
+    constexpr auto max = std::numeric_limits<long long>::max();
+
+    REQUIRE(detail::compareWithPow2Denominators({3, 16}, {1, 4}) < 0);
+    REQUIRE(detail::compareWithPow2Denominators({1, 4}, {3, 16}) > 0);
+    REQUIRE(detail::compareWithPow2Denominators({4, 16}, {1, 4}) == 0);
+    REQUIRE(detail::compareWithPow2Denominators({max, 1}, {1, 1LL << 62}) > 0);
+    REQUIRE(detail::compareWithPow2Denominators({-max, 1}, {1, 1LL << 62}) < 0);
+}
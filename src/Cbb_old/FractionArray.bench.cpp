@@ -0,0 +1,129 @@
+#define CATCH_CONFIG_MAIN
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include <catch2/catch.hpp>
+
+#include <Cbb/FractionArray.hpp>
+
+#include <random>
+
+
+using namespace Cbb;
+
+
+namespace {
+
+
+constexpr std::size_t numElements = 1'000'000;
+
+// Onsets and durations on duple and tuplet grids, none reduced
+std::vector<Fraction> makeFractions(const unsigned seed)
+{
+    constexpr long long grids[] = {4, 8, 16, 32, 64, 6, 12, 24, 20};
+
+    auto engine = std::mt19937_64(seed);
+    auto gridDistribution = std::uniform_int_distribution<std::size_t>(0, std::size(grids) - 1);
+    auto stepDistribution = std::uniform_int_distribution<long long>(0, 255);
+
+    auto fractions = std::vector<Fraction>();
+    fractions.reserve(numElements);
+
+    for (std::size_t i = 0; i < numElements; ++i)
+        fractions.emplace_back(stepDistribution(engine), grids[gridDistribution(engine)]);
+
+    return fractions;
+}
+
+
+} // namespace
+
+
+// Each benchmark processes numElements (10^6) elements, so elements per second is 10^6 divided
+// by the reported mean
+TEST_CASE("Bulk operations over 10^6 fractions", "[FractionArray][benchmark]")
+{
+    const auto left = makeFractions(1);
+    const auto right = makeFractions(2);
+
+    const auto leftArray = FractionArray(left);
+    const auto rightArray = FractionArray(right);
+
+    const auto threshold = Fraction(5, 3);
+    const auto scale = Fraction(3, 2);
+
+    WARN("AVX2 kernels " << (fractionArrayIsVectorized() ? "enabled" : "unavailable"));
+
+    BENCHMARK("scalar operator+")
+    {
+        auto sums = std::vector<Fraction>(numElements);
+
+        for (std::size_t i = 0; i < numElements; ++i)
+            sums[i] = left[i] + right[i];
+
+        return sums;
+    };
+
+    BENCHMARK("FractionArray operator+")
+    {
+        return leftArray + rightArray;
+    };
+
+    BENCHMARK("scalar operator*")
+    {
+        auto products = std::vector<Fraction>(numElements);
+
+        for (std::size_t i = 0; i < numElements; ++i)
+            products[i] = left[i] * scale;
+
+        return products;
+    };
+
+    BENCHMARK("FractionArray operator*")
+    {
+        return leftArray * scale;
+    };
+
+    BENCHMARK("scalar operator<")
+    {
+        auto results = std::vector<bool>(numElements);
+
+        for (std::size_t i = 0; i < numElements; ++i)
+            results[i] = left[i] < threshold;
+
+        return results;
+    };
+
+    BENCHMARK("FractionArray lessThan")
+    {
+        return lessThan(leftArray, threshold);
+    };
+
+    BENCHMARK("scalar floor")
+    {
+        auto results = std::vector<long long>(numElements);
+
+        for (std::size_t i = 0; i < numElements; ++i)
+            results[i] = floor(left[i]);
+
+        return results;
+    };
+
+    BENCHMARK("FractionArray floor")
+    {
+        return floor(leftArray);
+    };
+
+    BENCHMARK("scalar reduce")
+    {
+        auto results = std::vector<Fraction>(numElements);
+
+        for (std::size_t i = 0; i < numElements; ++i)
+            results[i] = reduce(left[i]);
+
+        return results;
+    };
+
+    BENCHMARK("FractionArray reduce")
+    {
+        return reduce(leftArray);
+    };
+}
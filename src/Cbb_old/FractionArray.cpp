@@ -0,0 +1,544 @@
+#include <Cbb/FractionArray.hpp>
+
+#include <stdexcept>
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#    define CBB_FRACTION_ARRAY_AVX2
+#    define CBB_TARGET_AVX2 __attribute__((target("avx2")))
+#    include <immintrin.h>
+#endif
+
+
+namespace Cbb {
+namespace {
+
+
+// The scalar kernels work on [first, last) so that the vector kernels can hand them any block
+// they cannot take, as well as the leftover tail
+
+void addScalar(const FractionArray& augends,
+               const FractionArray& addends,
+               FractionArray& sums,
+               const std::size_t first,
+               const std::size_t last)
+{
+    for (auto i = first; i < last; ++i)
+        sums.set(i, augends[i] + addends[i]);
+}
+
+void multiplyScalar(const FractionArray& multiplicands,
+                    const Fraction& multiplier,
+                    FractionArray& products,
+                    const std::size_t first,
+                    const std::size_t last)
+{
+    for (auto i = first; i < last; ++i)
+        products.set(i, multiplicands[i] * multiplier);
+}
+
+void lessThanScalar(const FractionArray& fractions,
+                    const Fraction& threshold,
+                    std::vector<bool>& results,
+                    const std::size_t first,
+                    const std::size_t last)
+{
+    for (auto i = first; i < last; ++i)
+        results[i] = fractions[i] < threshold;
+}
+
+void floorScalar(const FractionArray& fractions,
+                 std::vector<long long>& results,
+                 const std::size_t first,
+                 const std::size_t last)
+{
+    for (auto i = first; i < last; ++i)
+        results[i] = floor(fractions[i]);
+}
+
+void reduceScalar(const FractionArray& fractions,
+                  FractionArray& results,
+                  const std::size_t first,
+                  const std::size_t last)
+{
+    for (auto i = first; i < last; ++i)
+        results.set(i, reduce(fractions[i]));
+}
+
+
+#if defined(CBB_FRACTION_ARRAY_AVX2)
+
+// Every kernel below processes blocks of four elements. Lanes whose terms all fit in 32 bits are
+// computed in vector registers, where _mm256_mul_epi32 forms their products exactly; the scalar
+// kernel fills in any other lane of the block, as well as the leftover tail.
+
+constexpr std::size_t blockSize = 4;
+constexpr int allLanes = 0xF;
+
+CBB_TARGET_AVX2 inline __m256i load(const long long* const terms)
+{
+    return _mm256_load_si256(reinterpret_cast<const __m256i*>(terms));
+}
+
+CBB_TARGET_AVX2 inline void store(long long* const terms, const __m256i values)
+{
+    _mm256_store_si256(reinterpret_cast<__m256i*>(terms), values);
+}
+
+// One bit per lane, set where the lane of the mask is all ones
+CBB_TARGET_AVX2 inline int lanesOf(const __m256i mask)
+{
+    return _mm256_movemask_pd(_mm256_castsi256_pd(mask));
+}
+
+// Non-zero in every lane that does not fit in a signed 32 bit integer
+CBB_TARGET_AVX2 inline __m256i outside32Bits(const __m256i values)
+{
+    return _mm256_srli_epi64(_mm256_add_epi64(values, _mm256_set1_epi64x(1LL << 31)), 32);
+}
+
+CBB_TARGET_AVX2 inline int lanesWithin32Bits(const __m256i first, const __m256i second)
+{
+    const auto outside = _mm256_or_si256(outside32Bits(first), outside32Bits(second));
+
+    return lanesOf(_mm256_cmpeq_epi64(outside, _mm256_setzero_si256()));
+}
+
+CBB_TARGET_AVX2 inline int positiveLanes(const __m256i values)
+{
+    return lanesOf(_mm256_cmpgt_epi64(values, _mm256_setzero_si256()));
+}
+
+// The low 32 bits of each lane converted to double
+CBB_TARGET_AVX2 inline __m256d toDouble(const __m256i values)
+{
+    const auto lowHalves =
+        _mm256_permutevar8x32_epi32(values, _mm256_setr_epi32(0, 2, 4, 6, 0, 0, 0, 0));
+
+    return _mm256_cvtepi32_pd(_mm256_castsi256_si128(lowHalves));
+}
+
+CBB_TARGET_AVX2 void addAvx2(const FractionArray& augends,
+                             const FractionArray& addends,
+                             FractionArray& sums)
+{
+    auto i = std::size_t {0};
+
+    for (; i + blockSize <= sums.size(); i += blockSize)
+    {
+        const auto an = load(augends.numerators() + i);
+        const auto ad = load(augends.denominators() + i);
+        const auto bn = load(addends.numerators() + i);
+        const auto bd = load(addends.denominators() + i);
+
+        const auto vectorLanes = lanesWithin32Bits(an, ad) & lanesWithin32Bits(bn, bd);
+
+        if (vectorLanes == 0)
+        {
+            addScalar(augends, addends, sums, i, i + blockSize);
+            continue;
+        }
+
+        // The sums may overwrite the augends, so take the scalar lanes first
+        Fraction scalarSums[blockSize];
+
+        for (std::size_t lane = 0; lane < blockSize; ++lane)
+            if ((vectorLanes >> lane & 1) == 0)
+                scalarSums[lane] = augends[i + lane] + addends[i + lane];
+
+        // Like operator+, keep a common denominator as is rather than squaring it
+        const auto commonDenominator = _mm256_cmpeq_epi64(ad, bd);
+
+        const auto crossNumerator =
+            _mm256_add_epi64(_mm256_mul_epi32(an, bd), _mm256_mul_epi32(bn, ad));
+        const auto crossDenominator = _mm256_mul_epi32(ad, bd);
+
+        store(sums.numerators() + i,
+              _mm256_blendv_epi8(crossNumerator, _mm256_add_epi64(an, bn), commonDenominator));
+        store(sums.denominators() + i,
+              _mm256_blendv_epi8(crossDenominator, ad, commonDenominator));
+
+        for (std::size_t lane = 0; lane < blockSize; ++lane)
+            if ((vectorLanes >> lane & 1) == 0)
+                sums.set(i + lane, scalarSums[lane]);
+    }
+
+    addScalar(augends, addends, sums, i, sums.size());
+}
+
+CBB_TARGET_AVX2 void multiplyAvx2(const FractionArray& multiplicands,
+                                  const Fraction& multiplier,
+                                  FractionArray& products)
+{
+    const auto mn = _mm256_set1_epi64x(multiplier.numerator());
+    const auto md = _mm256_set1_epi64x(multiplier.denominator());
+
+    if (lanesWithin32Bits(mn, md) != allLanes)
+        return multiplyScalar(multiplicands, multiplier, products, 0, products.size());
+
+    auto i = std::size_t {0};
+
+    for (; i + blockSize <= products.size(); i += blockSize)
+    {
+        const auto n = load(multiplicands.numerators() + i);
+        const auto d = load(multiplicands.denominators() + i);
+
+        const auto vectorLanes = lanesWithin32Bits(n, d);
+
+        if (vectorLanes == 0)
+        {
+            multiplyScalar(multiplicands, multiplier, products, i, i + blockSize);
+            continue;
+        }
+
+        // The products may overwrite the multiplicands, so take the scalar lanes first
+        Fraction scalarProducts[blockSize];
+
+        for (std::size_t lane = 0; lane < blockSize; ++lane)
+            if ((vectorLanes >> lane & 1) == 0)
+                scalarProducts[lane] = multiplicands[i + lane] * multiplier;
+
+        store(products.numerators() + i, _mm256_mul_epi32(n, mn));
+        store(products.denominators() + i, _mm256_mul_epi32(d, md));
+
+        for (std::size_t lane = 0; lane < blockSize; ++lane)
+            if ((vectorLanes >> lane & 1) == 0)
+                products.set(i + lane, scalarProducts[lane]);
+    }
+
+    multiplyScalar(multiplicands, multiplier, products, i, products.size());
+}
+
+CBB_TARGET_AVX2 void lessThanAvx2(const FractionArray& fractions,
+                                  const Fraction& threshold,
+                                  std::vector<bool>& results)
+{
+    const auto tn = _mm256_set1_epi64x(threshold.numerator());
+    const auto td = _mm256_set1_epi64x(threshold.denominator());
+
+    if (lanesWithin32Bits(tn, td) != allLanes || positiveLanes(td) != allLanes)
+        return lessThanScalar(fractions, threshold, results, 0, fractions.size());
+
+    auto i = std::size_t {0};
+
+    for (; i + blockSize <= fractions.size(); i += blockSize)
+    {
+        const auto n = load(fractions.numerators() + i);
+        const auto d = load(fractions.denominators() + i);
+
+        // Cross multiplying only preserves the order over positive denominators
+        const auto vectorLanes = lanesWithin32Bits(n, d) & positiveLanes(d);
+
+        const auto less = _mm256_cmpgt_epi64(_mm256_mul_epi32(tn, d), _mm256_mul_epi32(n, td));
+        const auto lessLanes = lanesOf(less);
+
+        for (std::size_t lane = 0; lane < blockSize; ++lane)
+            results[i + lane] = ((vectorLanes >> lane & 1) != 0)
+                                    ? (lessLanes >> lane & 1) != 0
+                                    : fractions[i + lane] < threshold;
+    }
+
+    lessThanScalar(fractions, threshold, results, i, fractions.size());
+}
+
+CBB_TARGET_AVX2 void floorAvx2(const FractionArray& fractions, std::vector<long long>& results)
+{
+    const auto zero = _mm256_setzero_si256();
+
+    auto i = std::size_t {0};
+
+    for (; i + blockSize <= fractions.size(); i += blockSize)
+    {
+        const auto n = load(fractions.numerators() + i);
+        const auto d = load(fractions.denominators() + i);
+
+        const auto vectorLanes = lanesWithin32Bits(n, d) & positiveLanes(d);
+
+        if (vectorLanes == 0)
+        {
+            floorScalar(fractions, results, i, i + blockSize);
+            continue;
+        }
+
+        // Lanes with a zero denominator are overwritten below, so keep the division finite
+        const auto divisor = _mm256_blendv_pd(
+            _mm256_set1_pd(1.0), toDouble(d), _mm256_castsi256_pd(_mm256_cmpgt_epi64(d, zero)));
+
+        // The quotient in double precision can be off by one, so correct it from the remainder
+        const auto estimate = _mm256_floor_pd(_mm256_div_pd(toDouble(n), divisor));
+        auto quotient = _mm256_cvtepi32_epi64(_mm256_cvttpd_epi32(estimate));
+
+        const auto remainder = _mm256_sub_epi64(n, _mm256_mul_epi32(quotient, d));
+
+        // Comparisons give all-ones, i.e. -1, so adding one steps down and subtracting one steps up
+        quotient = _mm256_add_epi64(quotient, _mm256_cmpgt_epi64(zero, remainder));
+        quotient = _mm256_sub_epi64(
+            quotient, _mm256_cmpeq_epi64(_mm256_cmpgt_epi64(d, remainder), zero));
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(results.data() + i), quotient);
+
+        for (std::size_t lane = 0; lane < blockSize; ++lane)
+            if ((vectorLanes >> lane & 1) == 0)
+                results[i + lane] = floor(fractions[i + lane]);
+    }
+
+    floorScalar(fractions, results, i, fractions.size());
+}
+
+CBB_TARGET_AVX2 void reduceAvx2(const FractionArray& fractions, FractionArray& results)
+{
+    const auto zero = _mm256_setzero_si256();
+    const auto one = _mm256_set1_epi64x(1);
+
+    auto i = std::size_t {0};
+
+    for (; i + blockSize <= fractions.size(); i += blockSize)
+    {
+        const auto n = load(fractions.numerators() + i);
+        const auto d = load(fractions.denominators() + i);
+
+        const auto powerOf2Denominators =
+            _mm256_cmpeq_epi64(_mm256_and_si256(d, _mm256_sub_epi64(d, one)), zero);
+
+        const auto vectorLanes =
+            lanesWithin32Bits(n, d) & positiveLanes(d) & lanesOf(powerOf2Denominators);
+
+        if (vectorLanes == 0)
+        {
+            reduceScalar(fractions, results, i, i + blockSize);
+            continue;
+        }
+
+        // Over a power of two denominator, the gcd is the lesser of the denominator and the
+        // lowest set bit of the numerator, so dividing by it is a shift
+        const auto negative = _mm256_cmpgt_epi64(zero, n);
+        const auto magnitude = _mm256_sub_epi64(_mm256_xor_si256(n, negative), negative);
+        const auto lowestBit = _mm256_and_si256(magnitude, _mm256_sub_epi64(zero, magnitude));
+
+        const auto useDenominator =
+            _mm256_or_si256(_mm256_cmpeq_epi64(magnitude, zero), _mm256_cmpgt_epi64(lowestBit, d));
+        const auto gcd = _mm256_blendv_epi8(lowestBit, d, useDenominator);
+
+        // The exponent field of the gcd as a double is its binary logarithm
+        const auto shift = _mm256_sub_epi64(
+            _mm256_srli_epi64(_mm256_castpd_si256(toDouble(gcd)), 52), _mm256_set1_epi64x(1023));
+
+        const auto reducedMagnitude = _mm256_srlv_epi64(magnitude, shift);
+
+        store(results.numerators() + i,
+              _mm256_sub_epi64(_mm256_xor_si256(reducedMagnitude, negative), negative));
+        store(results.denominators() + i, _mm256_srlv_epi64(d, shift));
+
+        for (std::size_t lane = 0; lane < blockSize; ++lane)
+            if ((vectorLanes >> lane & 1) == 0)
+                results.set(i + lane, reduce(fractions[i + lane]));
+    }
+
+    reduceScalar(fractions, results, i, fractions.size());
+}
+
+#endif
+
+
+} // namespace
+
+
+FractionArray::FractionArray(const std::size_t size, const Fraction& value) :
+    numerators_(size, value.numerator()),
+    denominators_(size, value.denominator())
+{
+}
+
+FractionArray::FractionArray(const std::size_t size, Uninitialized)
+{
+    numerators_.resize(size);
+    denominators_.resize(size);
+}
+
+FractionArray::FractionArray(const std::initializer_list<Fraction> fractions)
+{
+    reserve(fractions.size());
+
+    for (const auto& fraction : fractions)
+        pushBack(fraction);
+}
+
+FractionArray::FractionArray(const std::vector<Fraction>& fractions)
+{
+    reserve(fractions.size());
+
+    for (const auto& fraction : fractions)
+        pushBack(fraction);
+}
+
+void FractionArray::reserve(const std::size_t capacity)
+{
+    numerators_.reserve(capacity);
+    denominators_.reserve(capacity);
+}
+
+void FractionArray::resize(const std::size_t size, const Fraction& value)
+{
+    numerators_.resize(size, value.numerator());
+    denominators_.resize(size, value.denominator());
+}
+
+void FractionArray::clear() noexcept
+{
+    numerators_.clear();
+    denominators_.clear();
+}
+
+void FractionArray::pushBack(const Fraction& fraction)
+{
+    numerators_.push_back(fraction.numerator());
+    denominators_.push_back(fraction.denominator());
+}
+
+Fraction FractionArray::operator[](const std::size_t index) const noexcept
+{
+    return {numerators_[index], denominators_[index]};
+}
+
+void FractionArray::set(const std::size_t index, const Fraction& fraction) noexcept
+{
+    numerators_[index] = fraction.numerator();
+    denominators_[index] = fraction.denominator();
+}
+
+std::vector<Fraction> FractionArray::toVector() const
+{
+    auto fractions = std::vector<Fraction>();
+    fractions.reserve(size());
+
+    for (std::size_t i = 0; i < size(); ++i)
+        fractions.push_back((*this)[i]);
+
+    return fractions;
+}
+
+FractionArray operator+(const FractionArray& augends, const FractionArray& addends)
+{
+    if (augends.size() != addends.size())
+        throw std::invalid_argument("fraction arrays must be the same size to be added");
+
+    auto sums = FractionArray(augends.size(), FractionArray::Uninitialized {});
+
+#if defined(CBB_FRACTION_ARRAY_AVX2)
+    if (fractionArrayIsVectorized())
+    {
+        addAvx2(augends, addends, sums);
+        return sums;
+    }
+#endif
+
+    addScalar(augends, addends, sums, 0, sums.size());
+    return sums;
+}
+
+FractionArray& operator+=(FractionArray& augends, const FractionArray& addends)
+{
+    if (augends.size() != addends.size())
+        throw std::invalid_argument("fraction arrays must be the same size to be added");
+
+#if defined(CBB_FRACTION_ARRAY_AVX2)
+    if (fractionArrayIsVectorized())
+    {
+        addAvx2(augends, addends, augends);
+        return augends;
+    }
+#endif
+
+    addScalar(augends, addends, augends, 0, augends.size());
+    return augends;
+}
+
+FractionArray operator*(const FractionArray& multiplicands, const Fraction& multiplier)
+{
+    auto products = FractionArray(multiplicands.size(), FractionArray::Uninitialized {});
+
+#if defined(CBB_FRACTION_ARRAY_AVX2)
+    if (fractionArrayIsVectorized())
+    {
+        multiplyAvx2(multiplicands, multiplier, products);
+        return products;
+    }
+#endif
+
+    multiplyScalar(multiplicands, multiplier, products, 0, products.size());
+    return products;
+}
+
+FractionArray& operator*=(FractionArray& multiplicands, const Fraction& multiplier)
+{
+#if defined(CBB_FRACTION_ARRAY_AVX2)
+    if (fractionArrayIsVectorized())
+    {
+        multiplyAvx2(multiplicands, multiplier, multiplicands);
+        return multiplicands;
+    }
+#endif
+
+    multiplyScalar(multiplicands, multiplier, multiplicands, 0, multiplicands.size());
+    return multiplicands;
+}
+
+std::vector<bool> lessThan(const FractionArray& fractions, const Fraction& threshold)
+{
+    auto results = std::vector<bool>(fractions.size());
+
+#if defined(CBB_FRACTION_ARRAY_AVX2)
+    if (fractionArrayIsVectorized())
+    {
+        lessThanAvx2(fractions, threshold, results);
+        return results;
+    }
+#endif
+
+    lessThanScalar(fractions, threshold, results, 0, fractions.size());
+    return results;
+}
+
+std::vector<long long> floor(const FractionArray& fractions)
+{
+    auto results = std::vector<long long>(fractions.size());
+
+#if defined(CBB_FRACTION_ARRAY_AVX2)
+    if (fractionArrayIsVectorized())
+    {
+        floorAvx2(fractions, results);
+        return results;
+    }
+#endif
+
+    floorScalar(fractions, results, 0, fractions.size());
+    return results;
+}
+
+FractionArray reduce(const FractionArray& fractions)
+{
+    auto results = FractionArray(fractions.size(), FractionArray::Uninitialized {});
+
+#if defined(CBB_FRACTION_ARRAY_AVX2)
+    if (fractionArrayIsVectorized())
+    {
+        reduceAvx2(fractions, results);
+        return results;
+    }
+#endif
+
+    reduceScalar(fractions, results, 0, fractions.size());
+    return results;
+}
+
+bool fractionArrayIsVectorized() noexcept
+{
+#if defined(CBB_FRACTION_ARRAY_AVX2)
+    static const bool supported = __builtin_cpu_supports("avx2");
+    return supported;
+#else
+    return false;
+#endif
+}
+
+
+}; // namespace Cbb
@@ -0,0 +1,140 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include <Cbb/FractionArray.hpp>
+
+#include <cstdint>
+#include <random>
+
+
+using namespace Cbb;
+
+
+namespace {
+
+
+// Mostly small duration-like fractions, with some that only the scalar kernels can take
+std::vector<Fraction> makeFractions(const std::size_t size, const unsigned seed)
+{
+    auto engine = std::mt19937_64(seed);
+    auto kind = std::uniform_int_distribution<int>(0, 9);
+    auto small = std::uniform_int_distribution<long long>(-1000, 1000);
+    auto exponent = std::uniform_int_distribution<int>(0, 10);
+    auto large = std::uniform_int_distribution<long long>(1LL << 32, 1LL << 40);
+
+    auto fractions = std::vector<Fraction>();
+
+    while (fractions.size() < size)
+    {
+        switch (kind(engine))
+        {
+            case 0:
+                fractions.emplace_back(large(engine), small(engine) | 1);
+                break;
+            case 1:
+                fractions.emplace_back(small(engine), -(small(engine) & 0xFF) - 1);
+                break;
+            case 2:
+                fractions.emplace_back(small(engine), 3 << exponent(engine));
+                break;
+            default:
+                fractions.emplace_back(small(engine), 1LL << exponent(engine));
+                break;
+        }
+    }
+
+    return fractions;
+}
+
+
+} // namespace
+
+
+TEST_CASE("A fraction array can be constructed from fractions", "[FractionArray]")
+{
+    const auto array = FractionArray({{1, 2}, {-3, 4}, {5, 6}});
+
+    REQUIRE(array.size() == 3);
+    REQUIRE(symbolicallyEqual(array[1], Fraction(-3, 4)));
+    REQUIRE(array.numerators()[2] == 5);
+    REQUIRE(array.denominators()[2] == 6);
+}
+
+TEST_CASE("A fraction array's terms are aligned for vector loads", "[FractionArray]")
+{
+    const auto array = FractionArray(13, Fraction(1, 3));
+
+    REQUIRE(reinterpret_cast<std::uintptr_t>(array.numerators()) % FractionArray::alignment == 0);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(array.denominators()) % FractionArray::alignment
+            == 0);
+}
+
+TEST_CASE("A fraction array can be modified element-wise", "[FractionArray]")
+{
+    auto array = FractionArray();
+    array.pushBack({1, 8});
+    array.pushBack({3, 8});
+    array.set(0, {7, 12});
+
+    REQUIRE(array.size() == 2);
+    REQUIRE(symbolicallyEqual(array[0], Fraction(7, 12)));
+    REQUIRE(array.toVector().size() == 2);
+
+    array.clear();
+
+    REQUIRE(array.empty());
+}
+
+TEST_CASE("Fraction arrays of different sizes cannot be added", "[FractionArray]")
+{
+    REQUIRE_THROWS_AS(FractionArray(2) + FractionArray(3), std::invalid_argument);
+}
+
+TEST_CASE("Bulk fraction array operations match the scalar operators", "[FractionArray]")
+{
+    const auto left = makeFractions(1003, 1);
+    const auto right = makeFractions(1003, 2);
+
+    const auto leftArray = FractionArray(left);
+    const auto rightArray = FractionArray(right);
+
+    SECTION("addition")
+    {
+        const auto sums = leftArray + rightArray;
+
+        for (std::size_t i = 0; i < left.size(); ++i)
+            REQUIRE(symbolicallyEqual(sums[i], left[i] + right[i]));
+    }
+
+    SECTION("multiplication by a fraction")
+    {
+        const auto products = leftArray * Fraction(3, 5);
+
+        for (std::size_t i = 0; i < left.size(); ++i)
+            REQUIRE(symbolicallyEqual(products[i], left[i] * Fraction(3, 5)));
+    }
+
+    SECTION("comparison to a threshold")
+    {
+        const auto results = lessThan(leftArray, Fraction(1, 7));
+
+        for (std::size_t i = 0; i < left.size(); ++i)
+            REQUIRE(results[i] == (left[i] < Fraction(1, 7)));
+    }
+
+    SECTION("floor")
+    {
+        const auto results = floor(leftArray);
+
+        for (std::size_t i = 0; i < left.size(); ++i)
+            REQUIRE(results[i] == floor(left[i]));
+    }
+
+    SECTION("reduction")
+    {
+        const auto results = reduce(leftArray);
+
+        for (std::size_t i = 0; i < left.size(); ++i)
+            REQUIRE(symbolicallyEqual(results[i], reduce(left[i])));
+    }
+}
@@ -0,0 +1,649 @@
+#define CATCH_CONFIG_MAIN
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include <catch2/catch.hpp>
+
+#include <Cbb/Metre.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <functional>
+#include <map>
+#include <new>
+#include <random>
+#include <vector>
+
+
+namespace {
+
+
+std::atomic<std::size_t> numAllocations {0};
+
+
+} // namespace
+
+
+// Counts every allocation in the program, so that a benchmark can check how many its loop makes
+void* operator new(const std::size_t size)
+{
+    ++numAllocations;
+
+    if (auto* const pointer = std::malloc(size == 0 ? 1 : size))
+        return pointer;
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void* const pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void* const pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+
+using namespace Cbb;
+
+
+namespace {
+
+
+std::vector<MetricPosition> makePositions(const std::size_t size)
+{
+    // Onsets on a mix of duple and tuplet grids, as produced by a quantizer
+    constexpr long long grids[] = {4, 8, 16, 32, 6, 12, 24, 20, 28};
+
+    auto engine = std::mt19937_64(42);
+    auto barDistribution = std::uniform_int_distribution<BarNumber>(0, 999);
+    auto gridDistribution = std::uniform_int_distribution<std::size_t>(0, std::size(grids) - 1);
+
+    auto positions = std::vector<MetricPosition>();
+    positions.reserve(size);
+
+    for (std::size_t i = 0; i < size; ++i)
+    {
+        const auto grid = grids[gridDistribution(engine)];
+        const auto step = std::uniform_int_distribution<long long>(0, grid - 1)(engine);
+
+        positions.emplace_back(barDistribution(engine), Fraction(4 * step, grid));
+    }
+
+    return positions;
+}
+
+// The ordering MetricPosition had before compare(): a cross multiplication per beat comparison
+bool crossMultiplyLess(const MetricPosition& left, const MetricPosition& right)
+{
+    if (left.bar != right.bar)
+        return left.bar < right.bar;
+
+    if (isUndefined(left.beat) || isUndefined(right.beat))
+        return false;
+
+    return left.beat.numerator() * right.beat.denominator()
+           < right.beat.numerator() * left.beat.denominator();
+}
+
+// A score with a tempo change every sixteenth note, as an exported tempo map can have
+MetricStructure makeMetricStructure(const std::size_t numBpmChanges)
+{
+    constexpr long long bpms[] = {60, 72, 80, 90, 96, 100, 108, 120, 132, 144};
+
+    auto metricStructure = MetricStructure(TimeSignature(4, 4), 120);
+
+    for (std::size_t i = 1; i < numBpmChanges; ++i)
+    {
+        const auto bar = static_cast<BarNumber>(i / 16);
+        const auto beat = Fraction(static_cast<long long>(i % 16), 4);
+
+        metricStructure.addBpmChange({bar, beat}, bpms[(i * 7) % std::size(bpms)]);
+    }
+
+    return metricStructure;
+}
+
+// How an offset was found before offsetOf: walking the bars from the initial bar
+Fraction walkOffsetOf(const MetricStructure& metricStructure, const MetricPosition& position)
+{
+    auto offset = FractionAccumulator();
+
+    for (BarNumber bar = 0; bar < position.bar; ++bar)
+    {
+        const auto timeSignature = metricStructure.lastestTimeSignatureChange(bar).second;
+        offset += Fraction(timeSignature.top(), timeSignature.bottom());
+    }
+
+    const auto timeSignature = metricStructure.lastestTimeSignatureChange(position).second;
+    offset += position.beat / timeSignature.bottom();
+
+    return offset.total();
+}
+
+
+// A tempo that ramps from one bar to the next, alternately linearly and exponentially
+MetricStructure makeRampedMetricStructure(const BarNumber numBars)
+{
+    constexpr long long bpms[] = {60, 72, 80, 90, 96, 100, 108, 120, 132, 144};
+
+    auto metricStructure = MetricStructure(TimeSignature(4, 4), 120);
+
+    for (BarNumber bar = 0; bar <= numBars; ++bar)
+    {
+        const auto ramp = (bar % 2 == 0) ? TempoRamp::linear : TempoRamp::exponential;
+        metricStructure.addBpmChange(bar, bpms[(bar * 7) % std::size(bpms)], ramp);
+    }
+
+    return metricStructure;
+}
+
+// How ramps were approximated before they were supported: a step every 25th of a beat, at the BPM
+// halfway through it
+MetricStructure makeSteppedMetricStructure(const MetricStructure& ramped, const BarNumber numBars)
+{
+    auto metricStructure = MetricStructure(TimeSignature(4, 4), 120);
+
+    for (BarNumber bar = 0; bar < numBars; ++bar)
+    {
+        for (long long step = 0; step < 100; ++step)
+        {
+            const auto bpm = ramped.approximateBpmAt({bar, Fraction(2 * step + 1, 50)});
+            metricStructure.addBpmChange({bar, Fraction(step, 25)},
+                                         Fraction(std::llround(bpm * 1000), 1000));
+        }
+    }
+
+    metricStructure.addBpmChange(numBars, ramped.lastestBpmChange(numBars).second);
+
+    return metricStructure;
+}
+
+// How blocks were rendered before BlockRenderer: finding the position at the last sample of each
+// block, and counting a beat wherever its whole beat differs from that of the previous block
+long long countBeatsByPosition(const MetricStructure& metricStructure,
+                               const long long sampleRate,
+                               const long long numSamples,
+                               const long long blockSize)
+{
+    auto numBeats = 0LL;
+    auto previous = MetricPosition(-1, 0);
+
+    for (auto blockStart = 0LL; blockStart < numSamples; blockStart += blockSize)
+    {
+        const auto seconds =
+            static_cast<double>(blockStart + blockSize - 1) / static_cast<double>(sampleRate);
+        const auto position = metricStructure.approximatePositionAt(seconds);
+
+        if (position.bar != previous.bar || floor(position.beat) != floor(previous.beat))
+            ++numBeats;
+
+        previous = position;
+    }
+
+    return numBeats;
+}
+
+
+} // namespace
+
+
+TEST_CASE("Sorting 10^7 metric positions", "[MetricPosition][benchmark]")
+{
+    const auto positions = makePositions(10'000'000);
+
+    BENCHMARK_ADVANCED("cross multiplication")(Catch::Benchmark::Chronometer meter)
+    {
+        auto copies = std::vector<std::vector<MetricPosition>>(meter.runs(), positions);
+        meter.measure([&](const int run) {
+            std::sort(copies[run].begin(), copies[run].end(), crossMultiplyLess);
+        });
+    };
+
+    BENCHMARK_ADVANCED("compare")(Catch::Benchmark::Chronometer meter)
+    {
+        auto copies = std::vector<std::vector<MetricPosition>>(meter.runs(), positions);
+        meter.measure([&](const int run) {
+            std::sort(copies[run].begin(), copies[run].end());
+        });
+    };
+
+    auto expected = positions;
+    std::sort(expected.begin(), expected.end(), crossMultiplyLess);
+
+    auto actual = positions;
+    std::sort(actual.begin(), actual.end());
+
+    CHECK(std::equal(expected.begin(),
+                     expected.end(),
+                     actual.begin(),
+                     [](const auto& left, const auto& right) {
+                         return !crossMultiplyLess(left, right) && !crossMultiplyLess(right, left);
+                     }));
+}
+
+TEST_CASE("Looking up the BPM at 10^6 positions among 10^5 BPM changes",
+          "[MetricStructure][benchmark]")
+{
+    const auto metricStructure = makeMetricStructure(100'000);
+    const auto positions = makePositions(1'000'000);
+
+    // The node-based storage MetricStructure had before its changes were flattened
+    const auto bpmChanges = metricStructure.bpmChanges();
+    const auto map = std::map<MetricPosition, TempoBpm, std::greater<MetricPosition>>(
+        bpmChanges.begin(), bpmChanges.end());
+
+    const auto sumFromMap = [&] {
+        auto checksum = 0LL;
+
+        for (const auto& position : positions)
+            checksum += map.lower_bound(position)->second.numerator();
+
+        return checksum;
+    };
+
+    const auto sumFromMetricStructure = [&] {
+        auto checksum = 0LL;
+
+        for (const auto& position : positions)
+            checksum += metricStructure.lastestBpmChange(position).second.numerator();
+
+        return checksum;
+    };
+
+    CHECK(sumFromMap() == sumFromMetricStructure());
+
+    BENCHMARK("std::map lower_bound") { return sumFromMap(); };
+
+    BENCHMARK("MetricStructure::lastestBpmChange") { return sumFromMetricStructure(); };
+}
+
+TEST_CASE("Finding the seconds at 10^6 positions among 10^5 BPM changes",
+          "[MetricStructure][benchmark]")
+{
+    auto metricStructure = makeMetricStructure(100'000);
+
+    for (BarNumber bar = 7; bar < 6250; bar += 13)
+        metricStructure.addTimeSignatureChange(bar, TimeSignature(3 + bar % 5, 4));
+
+    const auto positions = makePositions(1'000'000);
+
+    auto sortedPositions = positions;
+    std::sort(sortedPositions.begin(), sortedPositions.end());
+
+    auto seconds = std::vector<Fraction>(sortedPositions.size());
+
+    CHECK(metricStructure.approximateSecondsAt(6000)
+          == Approx(toDecimal(metricStructure.secondsAt(6000))));
+
+    BENCHMARK("secondsAt")
+    {
+        auto checksum = 0LL;
+
+        for (const auto& position : positions)
+            checksum += metricStructure.secondsAt(position).numerator();
+
+        return checksum;
+    };
+
+    BENCHMARK("approximateSecondsAt")
+    {
+        auto checksum = 0.0;
+
+        for (const auto& position : positions)
+            checksum += metricStructure.approximateSecondsAt(position);
+
+        return checksum;
+    };
+
+    BENCHMARK("secondsAt over sorted positions")
+    {
+        return metricStructure.secondsAt(
+            sortedPositions.begin(), sortedPositions.end(), seconds.begin());
+    };
+}
+
+TEST_CASE("Finding the positions of 10^7 increasing timestamps among 10^5 BPM changes",
+          "[MetricStructure][benchmark]")
+{
+    const auto metricStructure = makeMetricStructure(100'000);
+
+    // Events every 67 samples at 48 kHz, which spans most of the tempo map
+    constexpr long long numEvents = 10'000'000;
+    constexpr auto timestampAt = [](const long long event) { return Fraction(event * 67, 48'000); };
+
+    auto stream = metricStructure.positionStream();
+    auto last = MetricPosition();
+
+    for (long long event = 0; event < numEvents; event += 999'983)
+        CHECK(stream.positionAt(timestampAt(event))
+              == metricStructure.positionAt(timestampAt(event)));
+
+    BENCHMARK("positionAt")
+    {
+        for (long long event = 0; event < numEvents; ++event)
+            last = metricStructure.positionAt(timestampAt(event));
+
+        return last.bar;
+    };
+
+    BENCHMARK("PositionStream::positionAt")
+    {
+        auto stream = metricStructure.positionStream();
+
+        for (long long event = 0; event < numEvents; ++event)
+            last = stream.positionAt(timestampAt(event));
+
+        return last.bar;
+    };
+}
+
+TEST_CASE("Querying the changes at each of 10^6 audio blocks among 10^5 BPM changes",
+          "[MetricStructure][benchmark]")
+{
+    auto metricStructure = makeMetricStructure(100'000);
+
+    for (BarNumber bar = 7; bar < 6250; bar += 13)
+        metricStructure.addTimeSignatureChange(bar, TimeSignature(4, 4));
+
+    // A playhead advancing a 40th of a beat per block through 6250 bars of 4/4
+    constexpr long long blocksPerBar = 160;
+    constexpr long long numBlocks = 6250 * blocksPerBar;
+    constexpr auto positionAt = [](const long long block) {
+        return MetricPosition(block / blocksPerBar, Fraction(block % blocksPerBar, 40));
+    };
+
+    BENCHMARK("lastestTimeSignatureChange and lastestBpmChange")
+    {
+        auto checksum = 0LL;
+
+        for (long long block = 0; block < numBlocks; ++block)
+        {
+            const auto position = positionAt(block);
+
+            checksum += metricStructure.lastestTimeSignatureChange(position).second.top();
+            checksum += metricStructure.lastestBpmChange(position).second.numerator();
+        }
+
+        return checksum;
+    };
+
+    BENCHMARK("Cursor")
+    {
+        auto checksum = 0LL;
+        auto cursor = metricStructure.cursor(positionAt(0));
+
+        for (long long block = 0; block < numBlocks; ++block)
+        {
+            cursor.moveTo(positionAt(block));
+
+            checksum += cursor.lastestTimeSignatureChange().second.top();
+            checksum += cursor.lastestBpmChange().second.numerator();
+        }
+
+        return checksum;
+    };
+}
+
+TEST_CASE("Finding the offsets of 10^4 positions across 500 time signature changes",
+          "[MetricStructure][benchmark]")
+{
+    auto metricStructure = MetricStructure(TimeSignature(4, 4), 120);
+
+    for (BarNumber bar = 2; bar < 1000; bar += 2)
+        metricStructure.addTimeSignatureChange(bar, TimeSignature(3 + bar % 5, 4 << (bar % 3)));
+
+    auto positions = makePositions(10'000);
+
+    // Keep the beats within the shortest bar, of 3/16
+    for (auto& position : positions)
+        position.beat = Fraction(position.beat.numerator() % 3, position.beat.denominator());
+
+    for (std::size_t i = 0; i < positions.size(); i += 997)
+        CHECK(metricStructure.offsetOf(positions[i])
+              == walkOffsetOf(metricStructure, positions[i]));
+
+    BENCHMARK("walking the bars")
+    {
+        auto checksum = 0LL;
+
+        for (const auto& position : positions)
+            checksum += walkOffsetOf(metricStructure, position).numerator();
+
+        return checksum;
+    };
+
+    BENCHMARK("offsetOf")
+    {
+        auto checksum = 0LL;
+
+        for (const auto& position : positions)
+            checksum += metricStructure.offsetOf(position).numerator();
+
+        return checksum;
+    };
+}
+
+TEST_CASE("Finding the seconds at 10^6 positions across 1000 tempo ramps or 10^5 steps",
+          "[MetricStructure][benchmark]")
+{
+    const auto ramped = makeRampedMetricStructure(1000);
+    const auto stepped = makeSteppedMetricStructure(ramped, 1000);
+
+    const auto positions = makePositions(1'000'000);
+
+    auto seconds = std::vector<double>();
+    seconds.reserve(positions.size());
+
+    for (const auto& position : positions)
+        seconds.push_back(ramped.approximateSecondsAt(position));
+
+    for (BarNumber bar = 0; bar <= 1000; bar += 97)
+        CHECK(ramped.approximateSecondsAt(bar)
+              == Approx(stepped.approximateSecondsAt(bar)).epsilon(1e-4));
+
+    BENCHMARK("approximateSecondsAt with steps")
+    {
+        auto checksum = 0.0;
+
+        for (const auto& position : positions)
+            checksum += stepped.approximateSecondsAt(position);
+
+        return checksum;
+    };
+
+    BENCHMARK("approximateSecondsAt with ramps")
+    {
+        auto checksum = 0.0;
+
+        for (const auto& position : positions)
+            checksum += ramped.approximateSecondsAt(position);
+
+        return checksum;
+    };
+
+    BENCHMARK("approximatePositionAt with steps")
+    {
+        auto checksum = 0LL;
+
+        for (const auto seconds : seconds)
+            checksum += stepped.approximatePositionAt(seconds).bar;
+
+        return checksum;
+    };
+
+    BENCHMARK("approximatePositionAt with ramps")
+    {
+        auto checksum = 0LL;
+
+        for (const auto seconds : seconds)
+            checksum += ramped.approximatePositionAt(seconds).bar;
+
+        return checksum;
+    };
+}
+
+TEST_CASE("Importing 4000 BPM changes and 400 time signature changes",
+          "[MetricStructure][benchmark]")
+{
+    constexpr long long bpms[] = {60, 72, 80, 90, 96, 100, 108, 120, 132, 144};
+
+    auto timeSignatureChanges = std::vector<std::pair<BarNumber, TimeSignature>>();
+    auto bpmChanges = std::vector<std::pair<MetricPosition, TempoBpm>>();
+
+    for (BarNumber bar = 1; bar <= 400; ++bar)
+        timeSignatureChanges.emplace_back(bar * 2, TimeSignature(3 + bar % 5, 4));
+
+    for (std::size_t i = 1; i <= 4000; ++i)
+        bpmChanges.emplace_back(MetricPosition(static_cast<BarNumber>(i / 5),
+                                               Fraction(static_cast<long long>(i % 5), 2)),
+                                bpms[(i * 7) % std::size(bpms)]);
+
+    auto engine = std::mt19937_64(42);
+    auto shuffledTimeSignatureChanges = timeSignatureChanges;
+    auto shuffledBpmChanges = bpmChanges;
+    std::shuffle(shuffledTimeSignatureChanges.begin(), shuffledTimeSignatureChanges.end(), engine);
+    std::shuffle(shuffledBpmChanges.begin(), shuffledBpmChanges.end(), engine);
+
+    const auto add = [](const auto& timeSignatureChanges, const auto& bpmChanges) {
+        auto metricStructure = MetricStructure(TimeSignature(4, 4), 120);
+
+        for (const auto& [position, bpm] : bpmChanges)
+            metricStructure.addBpmChange(position, bpm);
+
+        for (const auto& [bar, timeSignature] : timeSignatureChanges)
+            metricStructure.addTimeSignatureChange(bar, timeSignature);
+
+        return metricStructure;
+    };
+
+    const auto assign = [](const auto& timeSignatureChanges, const auto& bpmChanges) {
+        auto metricStructure = MetricStructure(TimeSignature(4, 4), 120);
+        metricStructure.assignBpmChanges(bpmChanges);
+        metricStructure.assignTimeSignatureChanges(timeSignatureChanges);
+
+        return metricStructure;
+    };
+
+    CHECK(assign(shuffledTimeSignatureChanges, shuffledBpmChanges).secondsAt(799)
+          == add(timeSignatureChanges, bpmChanges).secondsAt(799));
+
+    BENCHMARK("adding sorted changes")
+    {
+        return add(timeSignatureChanges, bpmChanges);
+    };
+
+    BENCHMARK("adding shuffled changes")
+    {
+        return add(shuffledTimeSignatureChanges, shuffledBpmChanges);
+    };
+
+    BENCHMARK("assigning sorted changes")
+    {
+        return assign(timeSignatureChanges, bpmChanges);
+    };
+
+    BENCHMARK("assigning shuffled changes")
+    {
+        return assign(shuffledTimeSignatureChanges, shuffledBpmChanges);
+    };
+}
+
+TEST_CASE("Rendering a 3-hour session at 48 kHz in blocks of 64 samples",
+          "[MetricStructure][benchmark]")
+{
+    constexpr auto sampleRate = 48'000LL;
+    constexpr auto numSamples = 3 * 60 * 60 * sampleRate;
+    constexpr auto blockSize = 64LL;
+
+    auto metricStructure = makeMetricStructure(20'000);
+
+    for (BarNumber bar = 7; bar < 4000; bar += 13)
+        metricStructure.addTimeSignatureChange(bar, TimeSignature(3 + bar % 5, 4));
+
+    const auto render = [&metricStructure] {
+        auto renderer = metricStructure.blockRenderer(sampleRate);
+        auto events = std::array<MetricStructure::BlockRenderer::Event, blockSize>();
+        auto numBeats = 0LL;
+
+        while (renderer.sample() < numSamples)
+        {
+            const auto end = renderer.render(blockSize, events.data());
+
+            numBeats += std::count_if(events.data(), end, [](const auto& event) {
+                return event.kind != MetricStructure::BlockRenderer::Event::Kind::bpmChange;
+            });
+        }
+
+        return numBeats;
+    };
+
+    const auto allocationsBefore = numAllocations.load();
+    const auto numBeats = render();
+
+    CHECK(numAllocations.load() == allocationsBefore);
+    CHECK(numBeats == countBeatsByPosition(metricStructure, sampleRate, numSamples, blockSize));
+
+    BENCHMARK("approximatePositionAt at each block")
+    {
+        return countBeatsByPosition(metricStructure, sampleRate, numSamples, blockSize);
+    };
+
+    BENCHMARK("BlockRenderer")
+    {
+        return render();
+    };
+}
+
+TEST_CASE("Iterating the beats of 10^5 bars with 10^4 BPM changes",
+          "[MetricStructure][benchmark]")
+{
+    auto metricStructure = makeMetricStructure(10'000);
+
+    for (BarNumber bar = 7; bar < 100'000; bar += 13)
+        metricStructure.addTimeSignatureChange(bar, TimeSignature(3 + bar % 5, 4));
+
+    // How callers listed the beats before beats(): the time signature of each bar, and the seconds
+    // of each of its beats
+    const auto listBeats = [&metricStructure] {
+        auto checksum = 0.0;
+
+        for (BarNumber bar = 0; bar < 100'000; ++bar)
+        {
+            const auto timeSignature = metricStructure.lastestTimeSignatureChange(bar).second;
+
+            for (auto beat = 0; beat < timeSignature.top(); ++beat)
+                checksum += metricStructure.approximateSecondsAt({bar, beat});
+        }
+
+        return checksum;
+    };
+
+    const auto iterateBeats = [&metricStructure] {
+        auto checksum = 0.0;
+
+        for (const auto& beat : metricStructure.beats(0, 100'000))
+            checksum += beat.seconds;
+
+        return checksum;
+    };
+
+    const auto allocationsBefore = numAllocations.load();
+    const auto checksum = iterateBeats();
+
+    CHECK(numAllocations.load() == allocationsBefore);
+    CHECK(checksum == Approx(listBeats()));
+
+    BENCHMARK("lastestTimeSignatureChange and approximateSecondsAt")
+    {
+        return listBeats();
+    };
+
+    BENCHMARK("beats")
+    {
+        return iterateBeats();
+    };
+}
@@ -1,11 +1,235 @@
 #include <Cbb/Metre.hpp>
 
 #include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <optional>
+#include <stdexcept>
 
 
 namespace Cbb {
 
 
+namespace {
+
+
+// Changes may be const or not, to get an iterator of the same constness
+template <typename Changes, typename Key>
+auto findFirstAfter(Changes& changes, const Key& key)
+{
+    return std::upper_bound(
+        changes.begin(), changes.end(), key, [](const Key& key, const auto& change) {
+            return key < change.first;
+        });
+}
+
+// The index of the last value that the key is not before, or 0 if there is none. The search is
+// branchless, as the unpredictable comparisons of random lookups cost std::upper_bound more than
+// the comparisons themselves.
+template <typename T, typename Key, typename IsBefore>
+std::size_t findLast(const std::vector<T>& values, const Key& key, IsBefore isBefore) noexcept
+{
+    auto first = values.data();
+    auto size = values.size();
+
+    while (size > 1)
+    {
+        const auto half = size / 2;
+        first = isBefore(key, first[half]) ? first : first + half;
+        size -= half;
+    }
+
+    return static_cast<std::size_t>(first - values.data());
+}
+
+// The index of the last change at or before the key, or of the first change if there is none
+template <typename Change, typename Key>
+std::size_t findLatest(const std::vector<Change>& changes, const Key& key) noexcept
+{
+    return findLast(changes, key, [](const Key& key, const Change& change) {
+        return key < change.first;
+    });
+}
+
+// The index of the last change at or before the key, stepping forward from the index of the last
+// change at or before an earlier key, and searching if that takes more than maxSteps steps
+template <typename Change, typename Key>
+std::size_t advanceLatest(const std::vector<Change>& changes,
+                          std::size_t index,
+                          const Key& key,
+                          const std::size_t maxSteps) noexcept
+{
+    for (std::size_t step = 0; step < maxSteps; ++step)
+    {
+        if (index + 1 == changes.size() || key < changes[index + 1].first)
+            return index;
+
+        ++index;
+    }
+
+    return findLatest(changes, key);
+}
+
+// Division rounding towards negative infinity, for positions before the first change
+constexpr long long floorDivide(const long long dividend, const long long divisor) noexcept
+{
+    const auto quotient = dividend / divisor;
+
+    return (dividend % divisor != 0 && (dividend < 0) != (divisor < 0)) ? quotient - 1 : quotient;
+}
+
+// Returns the index of the added or replaced change
+template <typename Change, typename Key, typename Value>
+std::size_t insertOrAssign(std::vector<Change>& changes, const Key& key, const Value& value)
+{
+    // Changes are mostly added in order, so check the end before searching
+    if (changes.empty() || changes.back().first < key)
+    {
+        changes.emplace_back(key, value);
+        return changes.size() - 1;
+    }
+
+    const auto after = findFirstAfter(changes, key);
+
+    if (after != changes.begin() && std::prev(after)->first == key)
+    {
+        std::prev(after)->second = value;
+        return static_cast<std::size_t>(std::prev(after) - changes.begin());
+    }
+
+    // Emplacing can reallocate, so take the begin iterator after it
+    const auto inserted = changes.emplace(after, key, value);
+
+    return static_cast<std::size_t>(inserted - changes.begin());
+}
+
+// Returns the index the erased change had, if there was one
+template <typename Change, typename Key>
+std::optional<std::size_t> erase(std::vector<Change>& changes, const Key& key)
+{
+    const auto after = findFirstAfter(changes, key);
+
+    if (after == changes.begin() || !(std::prev(after)->first == key))
+        return std::nullopt;
+
+    const auto next = changes.erase(std::prev(after));
+
+    return static_cast<std::size_t>(next - changes.begin());
+}
+
+template <typename T>
+std::vector<T> permute(const std::vector<T>& values, const std::vector<std::size_t>& order)
+{
+    auto permuted = std::vector<T>();
+    permuted.reserve(order.size());
+
+    for (const auto index : order)
+        permuted.push_back(values[index]);
+
+    return permuted;
+}
+
+// Sorts changes assigned in any order, keeping the last of those with the same key, and reorders
+// the values parallel to them alike
+template <typename Change, typename... Parallel>
+void sortAssigned(std::vector<Change>& changes, std::vector<Parallel>&... parallel)
+{
+    const auto isBefore = [](const Change& left, const Change& right) {
+        return left.first < right.first;
+    };
+
+    if (!std::is_sorted(changes.begin(), changes.end(), isBefore))
+    {
+        auto order = std::vector<std::size_t>(changes.size());
+        std::iota(order.begin(), order.end(), std::size_t(0));
+
+        // Stable, so that the last of the changes with the same key stays last
+        std::stable_sort(order.begin(), order.end(), [&](const std::size_t left,
+                                                         const std::size_t right) {
+            return isBefore(changes[left], changes[right]);
+        });
+
+        changes = permute(changes, order);
+        ((parallel = permute(parallel, order)), ...);
+    }
+
+    auto size = std::size_t(0);
+
+    for (std::size_t i = 0; i < changes.size(); ++i)
+    {
+        if (size != 0 && changes[size - 1].first == changes[i].first)
+            --size;
+
+        changes[size] = changes[i];
+        ((parallel[size] = parallel[i]), ...);
+        ++size;
+    }
+
+    changes.resize(size);
+    (parallel.resize(size), ...);
+}
+
+constexpr long long secondsPerMinute = 60;
+
+// The seconds from the start of a tempo segment to the beats into it. A ramp starts at its change,
+// so before it, as before the first change, the tempo is that of the change.
+template <typename TempoSegment>
+double approximateSecondsInto(const TempoSegment& segment, const double beats) noexcept
+{
+    if (segment.ramp == TempoRamp::none || beats <= 0)
+        return beats * segment.approximateSecondsPerBeat;
+
+    const auto beatsPerSecond = segment.approximateBeatsPerSecond;
+    const auto rate = segment.approximateRampRate;
+
+    // Solving x = v t + a t^2 / 2 for t, in a form that does not cancel as a approaches 0
+    if (segment.ramp == TempoRamp::linear)
+        return 2 * beats
+               / (beatsPerSecond + std::sqrt(beatsPerSecond * beatsPerSecond + 2 * rate * beats));
+
+    // Solving x = v (e^(g t) - 1) / g for t
+    return std::log1p(rate * beats / beatsPerSecond) / rate;
+}
+
+// The beats from the start of a tempo segment to the seconds into it
+template <typename TempoSegment>
+double approximateBeatsInto(const TempoSegment& segment, const double seconds) noexcept
+{
+    const auto beatsPerSecond = segment.approximateBeatsPerSecond;
+    const auto rate = segment.approximateRampRate;
+
+    if (segment.ramp == TempoRamp::none || seconds <= 0)
+        return seconds * beatsPerSecond;
+
+    if (segment.ramp == TempoRamp::linear)
+        return seconds * (beatsPerSecond + rate * seconds / 2);
+
+    return beatsPerSecond * std::expm1(rate * seconds) / rate;
+}
+
+// The tempo at the beats into a tempo segment
+template <typename TempoSegment>
+double approximateBeatsPerSecondInto(const TempoSegment& segment, const double beats) noexcept
+{
+    const auto beatsPerSecond = segment.approximateBeatsPerSecond;
+    const auto rate = segment.approximateRampRate;
+
+    if (segment.ramp == TempoRamp::none || beats <= 0)
+        return beatsPerSecond;
+
+    // v^2 = v0^2 + 2 a x
+    if (segment.ramp == TempoRamp::linear)
+        return std::sqrt(beatsPerSecond * beatsPerSecond + 2 * rate * beats);
+
+    return beatsPerSecond + rate * beats;
+}
+
+
+} // namespace
+
+
 MetricStructure::MetricStructure(const TimeSignature& defaultTimeSignature,
                                  const TempoBpm& defaultBpm,
                                  const BarNumber initialBar) :
@@ -13,19 +237,33 @@ MetricStructure::MetricStructure(const TimeSignature& defaultTimeSignature,
     defaultBpm_ {defaultBpm},
     initialBar_ {initialBar},
     timeSignatureChanges_ {{initialBar, defaultTimeSignature}},
-    bpmChanges_ {{initialBar, defaultBpm}}
+    bpmChanges_ {{initialBar, defaultBpm}},
+    bpmRamps_ {TempoRamp::none}
 {
+    updateMeterSegmentsFrom(0);
+    updateTempoSegmentsFrom(0);
 }
 
 void MetricStructure::addTimeSignatureChange(const BarNumber bar,
                                              const TimeSignature& timeSignature)
 {
-    timeSignatureChanges_[bar] = timeSignature;
+    updateMeterSegmentsFrom(insertOrAssign(timeSignatureChanges_, bar, timeSignature));
+    updateTempoSegmentsAfter(bar);
 }
 
-void MetricStructure::addBpmChange(const MetricPosition& position, const TempoBpm& bpm)
+void MetricStructure::addBpmChange(const MetricPosition& position,
+                                   const TempoBpm& bpm,
+                                   const TempoRamp ramp)
 {
-    bpmChanges_[position] = bpm;
+    const auto numBpmChanges = bpmChanges_.size();
+    const auto index = insertOrAssign(bpmChanges_, position, bpm);
+
+    if (bpmChanges_.size() == numBpmChanges)
+        bpmRamps_[index] = ramp;
+    else
+        bpmRamps_.insert(bpmRamps_.begin() + static_cast<std::ptrdiff_t>(index), ramp);
+
+    updateTempoSegmentsFrom(index);
 }
 
 bool MetricStructure::eraseTimeSignatureChangeAt(const BarNumber bar)
@@ -33,12 +271,13 @@ bool MetricStructure::eraseTimeSignatureChangeAt(const BarNumber bar)
     if (bar <= initialBar_)
         return false;
 
-    const auto found = timeSignatureChanges_.find(bar);
+    const auto index = erase(timeSignatureChanges_, bar);
 
-    if (found == timeSignatureChanges_.end())
+    if (!index)
         return false;
 
-    timeSignatureChanges_.erase(found);
+    updateMeterSegmentsFrom(*index);
+    updateTempoSegmentsAfter(bar);
 
     return true;
 }
@@ -48,39 +287,662 @@ bool MetricStructure::eraseBpmChangeAt(const MetricPosition& position)
     if (position <= initialBar_)
         return false;
 
-    const auto found = bpmChanges_.find(position);
+    const auto index = erase(bpmChanges_, position);
 
-    if (found == bpmChanges_.end())
+    if (!index)
         return false;
 
-    bpmChanges_.erase(found);
+    bpmRamps_.erase(bpmRamps_.begin() + static_cast<std::ptrdiff_t>(*index));
+    updateTempoSegmentsFrom(*index);
 
     return true;
 }
 
-std::vector<std::pair<BarNumber, TimeSignature>> MetricStructure::timeSignatureChanges() const
+void MetricStructure::updateAssignedTimeSignatureChanges()
 {
-    return std::vector<std::pair<BarNumber, TimeSignature>>(timeSignatureChanges_.rbegin(),
-                                                            timeSignatureChanges_.rend());
+    sortAssigned(timeSignatureChanges_);
+    updateMeterSegmentsFrom(0);
+    updateTempoSegmentsFrom(0);
 }
 
-std::vector<std::pair<MetricPosition, TempoBpm>> MetricStructure::bpmChanges() const
+void MetricStructure::updateAssignedBpmChanges()
 {
-    return std::vector<std::pair<MetricPosition, TempoBpm>>(bpmChanges_.rbegin(),
-                                                            bpmChanges_.rend());
+    sortAssigned(bpmChanges_, bpmRamps_);
+    updateTempoSegmentsFrom(0);
+}
+
+TimeSignatureChanges MetricStructure::timeSignatureChanges() const noexcept
+{
+    return {timeSignatureChanges_.data(), timeSignatureChanges_.size()};
+}
+
+BpmChanges MetricStructure::bpmChanges() const noexcept
+{
+    return {bpmChanges_.data(), bpmChanges_.size()};
 }
 
 std::pair<BarNumber, TimeSignature>
 MetricStructure::lastestTimeSignatureChange(const MetricPosition& position) const
 {
-    return *timeSignatureChanges_.lower_bound(position.bar);
+    return timeSignatureChanges_[findLatest(timeSignatureChanges_, position.bar)];
 }
 
 std::pair<MetricPosition, TempoBpm>
 MetricStructure::lastestBpmChange(const MetricPosition& position) const
 {
-    return *bpmChanges_.lower_bound(position);
+    return bpmChanges_[findLatest(bpmChanges_, position)];
+}
+
+TempoRamp MetricStructure::lastestBpmRamp(const MetricPosition& position) const noexcept
+{
+    return bpmRamps_[findLatest(bpmChanges_, position)];
+}
+
+double MetricStructure::approximateBpmAt(const MetricPosition& position) const noexcept
+{
+    const auto& segment = tempoSegments_[findLatest(bpmChanges_, position)];
+    const auto beats =
+        approximateBeatsOf(position, findLatest(timeSignatureChanges_, position.bar));
+
+    return approximateBeatsPerSecondInto(segment, beats - segment.approximateBeats)
+           * secondsPerMinute;
+}
+
+Fraction MetricStructure::secondsAt(const MetricPosition& position) const
+{
+    return secondsWithin(position,
+                         findLatest(timeSignatureChanges_, position.bar),
+                         findLatest(bpmChanges_, position));
+}
+
+double MetricStructure::approximateSecondsAt(const MetricPosition& position) const noexcept
+{
+    return approximateSecondsWithin(position,
+                                    findLatest(timeSignatureChanges_, position.bar),
+                                    findLatest(bpmChanges_, position));
+}
+
+double MetricStructure::approximateSecondsWithin(const MetricPosition& position,
+                                                 const std::size_t timeSignatureIndex,
+                                                 const std::size_t bpmIndex) const noexcept
+{
+    const auto& segment = tempoSegments_[bpmIndex];
+    const auto beats = approximateBeatsOf(position, timeSignatureIndex);
+
+    return segment.approximateSeconds
+           + approximateSecondsInto(segment, beats - segment.approximateBeats);
+}
+
+MetricPosition MetricStructure::positionAt(const Fraction& seconds) const
+{
+    const auto beats = beatsWithin(seconds, findTempoSegment(seconds));
+
+    return positionWithin(beats, findTimeSignatureChange(floor(beats)));
+}
+
+MetricPosition MetricStructure::approximatePositionAt(const double seconds) const
+{
+    const auto& segment = tempoSegments_[findTempoSegment(seconds)];
+    const auto beats =
+        segment.approximateBeats + approximateBeatsInto(segment, seconds - segment.approximateSeconds);
+    const auto ticks = std::llround(beats * static_cast<double>(approximateBeatResolution));
+
+    return positionWithin(reduce(Fraction(ticks, approximateBeatResolution)),
+                          findTimeSignatureChange(floorDivide(ticks, approximateBeatResolution)));
+}
+
+Fraction MetricStructure::offsetOf(const MetricPosition& position) const
+{
+    const auto timeSignatureIndex = findLatest(timeSignatureChanges_, position.bar);
+    const auto wholeNotes =
+        boundedSum(wholeNotesBefore(position.bar, timeSignatureIndex),
+                   position.beat * meterSegments_[timeSignatureIndex].beatLength);
+
+    return reduce(boundedDifference(wholeNotes, initialBarWholeNotes_));
+}
+
+MetricPosition MetricStructure::positionAtOffset(const Fraction& wholeNotes) const
+{
+    const auto fromFirstChange = reduce(boundedSum(wholeNotes, initialBarWholeNotes_));
+    const auto timeSignatureIndex = findTimeSignatureChange(fromFirstChange);
+    const auto& segment = meterSegments_[timeSignatureIndex];
+
+    const auto beatsIntoChange =
+        boundedDifference(fromFirstChange, segment.wholeNotes) / segment.beatLength;
+
+    return positionWithin(reduce(boundedSum(segment.beats, beatsIntoChange)), timeSignatureIndex);
+}
+
+MetricStructure::PositionStream MetricStructure::positionStream() const noexcept
+{
+    return PositionStream(*this);
+}
+
+MetricStructure::Cursor MetricStructure::cursor(const MetricPosition& position) const noexcept
+{
+    return Cursor(*this, position);
+}
+
+MetricStructure::BeatRange MetricStructure::beats(const MetricPosition& from,
+                                                  const MetricPosition& to,
+                                                  const int subdivision) const
+{
+    if (subdivision <= 0)
+        throw std::invalid_argument("a subdivision must be positive");
+
+    return BeatRange(*this, from, to, subdivision);
+}
+
+MetricStructure::BlockRenderer MetricStructure::blockRenderer(const long long sampleRate,
+                                                              const long long sample) const
+{
+    if (sampleRate <= 0)
+        throw std::invalid_argument("a sample rate must be positive");
+
+    return BlockRenderer(*this, sampleRate, sample);
+}
+
+long long MetricStructure::beatsBefore(const BarNumber bar,
+                                       const std::size_t timeSignatureIndex) const noexcept
+{
+    const auto& [changeBar, timeSignature] = timeSignatureChanges_[timeSignatureIndex];
+
+    return meterSegments_[timeSignatureIndex].beats + (bar - changeBar) * timeSignature.top();
+}
+
+double MetricStructure::approximateBeatsOf(const MetricPosition& position,
+                                           const std::size_t timeSignatureIndex) const noexcept
+{
+    return static_cast<double>(beatsBefore(position.bar, timeSignatureIndex))
+           + static_cast<double>(position.beat.numerator())
+                 / static_cast<double>(position.beat.denominator());
+}
+
+Fraction MetricStructure::wholeNotesBefore(const BarNumber bar,
+                                           const std::size_t timeSignatureIndex) const
+{
+    const auto& segment = meterSegments_[timeSignatureIndex];
+    const auto beatsIntoChange = beatsBefore(bar, timeSignatureIndex) - segment.beats;
+
+    return reduce(boundedSum(segment.wholeNotes, beatsIntoChange * segment.beatLength));
+}
+
+Fraction MetricStructure::secondsWithin(const MetricPosition& position,
+                                        const std::size_t timeSignatureIndex,
+                                        const std::size_t bpmIndex) const
+{
+    const auto& segment = tempoSegments_[bpmIndex];
+    const auto beats = boundedSum(beatsBefore(position.bar, timeSignatureIndex), position.beat);
+    const auto beatsIntoSegment = reduce(boundedDifference(beats, segment.beats));
+
+    if (segment.seconds == unknownSeconds)
+        throw std::domain_error("the seconds after an exponential tempo ramp are irrational");
+
+    if (segment.ramp != TempoRamp::none && beatsIntoSegment > 0)
+        throw std::domain_error("the seconds within a tempo ramp are irrational");
+
+    return reduce(boundedSum(segment.seconds,
+                             beatsIntoSegment * secondsPerMinute / bpmChanges_[bpmIndex].second));
+}
+
+std::size_t MetricStructure::findTempoSegment(const Fraction& seconds) const noexcept
+{
+    return findLast(
+        tempoSegments_, seconds, [](const Fraction& seconds, const TempoSegment& segment) {
+            return seconds < segment.seconds;
+        });
+}
+
+std::size_t MetricStructure::findTempoSegment(const double seconds) const noexcept
+{
+    return findLast(tempoSegments_, seconds, [](const double seconds, const TempoSegment& segment) {
+        return seconds < segment.approximateSeconds;
+    });
+}
+
+std::size_t MetricStructure::findTimeSignatureChange(const long long beats) const noexcept
+{
+    return findLast(meterSegments_, beats, [](const long long beats, const MeterSegment& segment) {
+        return beats < segment.beats;
+    });
+}
+
+std::size_t MetricStructure::findTimeSignatureChange(const Fraction& wholeNotes) const noexcept
+{
+    return findLast(
+        meterSegments_, wholeNotes, [](const Fraction& wholeNotes, const MeterSegment& segment) {
+            return wholeNotes < segment.wholeNotes;
+        });
+}
+
+Fraction MetricStructure::beatsWithin(const Fraction& seconds, const std::size_t bpmIndex) const
+{
+    const auto& segment = tempoSegments_[bpmIndex];
+    const auto secondsIntoSegment = reduce(boundedDifference(seconds, segment.seconds));
+
+    if (segment.seconds == unknownSeconds
+        || (segment.ramp == TempoRamp::exponential && secondsIntoSegment > 0))
+        throw std::domain_error("the beats within or after an exponential tempo ramp are irrational");
+
+    const auto beatsIntoSegment = reduce(secondsIntoSegment * segment.beatsPerSecond);
+
+    if (segment.ramp != TempoRamp::linear || !(secondsIntoSegment > 0))
+        return reduce(boundedSum(segment.beats, beatsIntoSegment));
+
+    // x = v t + a t^2 / 2
+    const auto rampBeats =
+        reduce(secondsIntoSegment * secondsIntoSegment * segment.beatsPerSecondSquared / 2);
+
+    return reduce(boundedSum(segment.beats, boundedSum(beatsIntoSegment, rampBeats)));
+}
+
+MetricPosition MetricStructure::positionWithin(const Fraction& beats,
+                                               const std::size_t timeSignatureIndex) const
+{
+    const auto& [changeBar, timeSignature] = timeSignatureChanges_[timeSignatureIndex];
+    const auto beatsIntoChange = floor(beats) - meterSegments_[timeSignatureIndex].beats;
+    const auto bars = floorDivide(beatsIntoChange, timeSignature.top());
+    const auto bar = changeBar + bars;
+
+    // Taking a whole number from a reduced fraction leaves it reduced
+    const auto wholeBeats = beatsBefore(bar, timeSignatureIndex);
+
+    return {bar,
+            Fraction(beats.numerator() - wholeBeats * beats.denominator(), beats.denominator())};
+}
+
+void MetricStructure::updateMeterSegmentsFrom(const std::size_t index)
+{
+    meterSegments_.resize(timeSignatureChanges_.size());
+
+    for (auto i = index; i < timeSignatureChanges_.size(); ++i)
+    {
+        auto& segment = meterSegments_[i];
+
+        // The beat unit of a time signature is a 1/bottom note
+        segment.beatLength = Fraction(1, timeSignatureChanges_[i].second.bottom());
+
+        if (i == 0)
+        {
+            segment.beats = 0;
+            segment.wholeNotes = 0;
+            continue;
+        }
+
+        const auto& previous = meterSegments_[i - 1];
+        const auto beats = beatsBefore(timeSignatureChanges_[i].first, i - 1);
+
+        segment.beats = beats;
+        segment.wholeNotes = reduce(
+            boundedSum(previous.wholeNotes, (beats - previous.beats) * previous.beatLength));
+    }
+
+    initialBarWholeNotes_ =
+        wholeNotesBefore(initialBar_, findLatest(timeSignatureChanges_, initialBar_));
+}
+
+void MetricStructure::updateTempoSegmentsFrom(const std::size_t index)
+{
+    tempoSegments_.resize(bpmChanges_.size());
+
+    // The ramp of the change before the index leads to the change at it
+    for (auto i = (index == 0) ? index : index - 1; i < bpmChanges_.size(); ++i)
+    {
+        const auto& [position, bpm] = bpmChanges_[i];
+        const auto timeSignatureIndex = findLatest(timeSignatureChanges_, position.bar);
+        auto& segment = tempoSegments_[i];
+
+        segment.beats =
+            reduce(boundedSum(beatsBefore(position.bar, timeSignatureIndex), position.beat));
+        segment.beatsPerSecond = reduce(bpm / secondsPerMinute);
+        segment.approximateBeats = static_cast<double>(toDecimal(segment.beats));
+        segment.approximateSecondsPerBeat = static_cast<double>(toDecimal(secondsPerMinute / bpm));
+        segment.approximateBeatsPerSecond = static_cast<double>(toDecimal(segment.beatsPerSecond));
+
+        // Until the next change sets the ramp to it
+        segment.ramp = TempoRamp::none;
+        segment.beatsPerSecondSquared = 0;
+        segment.approximateRampRate = 0;
+
+        if (i == 0)
+        {
+            segment.seconds = 0;
+            segment.approximateSeconds = 0;
+            continue;
+        }
+
+        updateTempoRamp(i - 1);
+
+        const auto& previous = tempoSegments_[i - 1];
+
+        if (previous.seconds == unknownSeconds || previous.ramp == TempoRamp::exponential)
+            segment.seconds = unknownSeconds;
+        else if (previous.ramp == TempoRamp::linear)
+        {
+            // A linear ramp lasts as long as its mean tempo would
+            const auto beats = reduce(boundedDifference(segment.beats, previous.beats));
+            const auto meanBeatsPerSecond =
+                reduce(boundedSum(previous.beatsPerSecond, segment.beatsPerSecond)) / 2;
+
+            segment.seconds = reduce(boundedSum(previous.seconds, beats / meanBeatsPerSecond));
+        }
+        else
+            segment.seconds = secondsWithin(position, timeSignatureIndex, i - 1);
+
+        // Summed apart from the exact seconds, so that it stays close even where they overflow or
+        // are irrational
+        segment.approximateSeconds =
+            previous.approximateSeconds
+            + approximateSecondsInto(previous, segment.approximateBeats - previous.approximateBeats);
+    }
+}
+
+void MetricStructure::updateTempoRamp(const std::size_t index)
+{
+    auto& segment = tempoSegments_[index];
+    const auto& next = tempoSegments_[index + 1];
+
+    segment.ramp =
+        (segment.beatsPerSecond == next.beatsPerSecond) ? TempoRamp::none : bpmRamps_[index];
+
+    const auto beats = reduce(boundedDifference(next.beats, segment.beats));
+    const auto approximateBeats = next.approximateBeats - segment.approximateBeats;
+    const auto beatsPerSecond = segment.approximateBeatsPerSecond;
+    const auto nextBeatsPerSecond = next.approximateBeatsPerSecond;
+
+    // v1^2 = v0^2 + 2 a x
+    if (segment.ramp == TempoRamp::linear)
+    {
+        const auto squares =
+            boundedDifference(reduce(next.beatsPerSecond * next.beatsPerSecond),
+                              reduce(segment.beatsPerSecond * segment.beatsPerSecond));
+
+        segment.beatsPerSecondSquared = reduce(reduce(squares) / (2 * beats));
+        segment.approximateRampRate =
+            (nextBeatsPerSecond * nextBeatsPerSecond - beatsPerSecond * beatsPerSecond)
+            / (2 * approximateBeats);
+    }
+
+    // The tempo grows by the same beats per second every beat
+    if (segment.ramp == TempoRamp::exponential)
+        segment.approximateRampRate = (nextBeatsPerSecond - beatsPerSecond) / approximateBeats;
+}
+
+void MetricStructure::updateTempoSegmentsAfter(const BarNumber bar)
+{
+    const auto firstAffected = std::partition_point(
+        bpmChanges_.begin(), bpmChanges_.end(), [bar](const auto& change) {
+            return change.first.bar <= bar;
+        });
+
+    updateTempoSegmentsFrom(static_cast<std::size_t>(firstAffected - bpmChanges_.begin()));
 }
 
+MetricStructure::PositionStream::PositionStream(const MetricStructure& metricStructure) noexcept :
+    metricStructure_ {&metricStructure},
+    previousSeconds_ {metricStructure.tempoSegments_.front().seconds}
+{
+}
+
+MetricPosition MetricStructure::PositionStream::positionAt(const Fraction& seconds)
+{
+    const auto& segments = metricStructure_->tempoSegments_;
+    const auto& meterSegments = metricStructure_->meterSegments_;
+
+    const auto isSeek = seconds < previousSeconds_;
+    previousSeconds_ = seconds;
+
+    if (isSeek)
+        bpmIndex_ = metricStructure_->findTempoSegment(seconds);
+    else
+        while (bpmIndex_ + 1 < segments.size() && segments[bpmIndex_ + 1].seconds <= seconds)
+            ++bpmIndex_;
+
+    const auto beats = metricStructure_->beatsWithin(seconds, bpmIndex_);
+    const auto wholeBeats = floor(beats);
+
+    if (isSeek)
+        timeSignatureIndex_ = metricStructure_->findTimeSignatureChange(wholeBeats);
+    else
+        while (timeSignatureIndex_ + 1 < meterSegments.size()
+               && meterSegments[timeSignatureIndex_ + 1].beats <= wholeBeats)
+            ++timeSignatureIndex_;
+
+    return metricStructure_->positionWithin(beats, timeSignatureIndex_);
+}
+
+MetricStructure::Cursor::Cursor(const MetricStructure& metricStructure,
+                                const MetricPosition& position) noexcept :
+    metricStructure_ {&metricStructure},
+    position_ {position},
+    timeSignatureIndex_ {findLatest(metricStructure.timeSignatureChanges_, position.bar)},
+    bpmIndex_ {findLatest(metricStructure.bpmChanges_, position)}
+{
+}
+
+void MetricStructure::Cursor::moveTo(const MetricPosition& position) noexcept
+{
+    const auto& timeSignatureChanges = metricStructure_->timeSignatureChanges_;
+    const auto& bpmChanges = metricStructure_->bpmChanges_;
+
+    if (position < position_)
+    {
+        timeSignatureIndex_ = findLatest(timeSignatureChanges, position.bar);
+        bpmIndex_ = findLatest(bpmChanges, position);
+    }
+    else
+    {
+        timeSignatureIndex_ =
+            advanceLatest(timeSignatureChanges, timeSignatureIndex_, position.bar, maxSteps);
+        bpmIndex_ = advanceLatest(bpmChanges, bpmIndex_, position, maxSteps);
+    }
+
+    position_ = position;
+}
+
+const std::pair<BarNumber, TimeSignature>&
+MetricStructure::Cursor::lastestTimeSignatureChange() const noexcept
+{
+    return metricStructure_->timeSignatureChanges_[timeSignatureIndex_];
+}
+
+const std::pair<MetricPosition, TempoBpm>&
+MetricStructure::Cursor::lastestBpmChange() const noexcept
+{
+    return metricStructure_->bpmChanges_[bpmIndex_];
+}
+
+Fraction MetricStructure::Cursor::seconds() const
+{
+    return metricStructure_->secondsWithin(position_, timeSignatureIndex_, bpmIndex_);
+}
+
+double MetricStructure::Cursor::approximateSeconds() const noexcept
+{
+    return metricStructure_->approximateSecondsWithin(position_, timeSignatureIndex_, bpmIndex_);
+}
+
+MetricStructure::BeatRange::BeatRange(const MetricStructure& metricStructure,
+                                      const MetricPosition& from,
+                                      const MetricPosition& to,
+                                      const int subdivision) :
+    metricStructure_ {&metricStructure},
+    subdivision_ {subdivision},
+    first_ {firstAtOrAfter(from)},
+    last_ {firstAtOrAfter(to)}
+{
+    // An empty range, rather than one that never reaches its end
+    if (last_ < first_)
+        first_ = last_;
+}
+
+MetricStructure::BeatRange::Iterator MetricStructure::BeatRange::begin() const
+{
+    return Iterator(*metricStructure_, subdivision_, first_);
+}
+
+MetricStructure::BeatRange::Iterator MetricStructure::BeatRange::end() const
+{
+    return Iterator(*metricStructure_, subdivision_, last_);
+}
+
+std::pair<BarNumber, long long>
+MetricStructure::BeatRange::firstAtOrAfter(const MetricPosition& position) const
+{
+    const auto& timeSignature = metricStructure_->lastestTimeSignatureChange(position).second;
+    const auto subdivisionInBar = std::max(ceil(position.beat * subdivision_), 0LL);
+
+    if (subdivisionInBar >= static_cast<long long>(timeSignature.top()) * subdivision_)
+        return {position.bar + 1, 0};
+
+    return {position.bar, subdivisionInBar};
+}
+
+MetricStructure::BeatRange::Iterator::Iterator(
+    const MetricStructure& metricStructure,
+    const int subdivision,
+    const std::pair<BarNumber, long long> subdivisionPosition) noexcept :
+    metricStructure_ {&metricStructure},
+    subdivision_ {subdivision},
+    bar_ {subdivisionPosition.first},
+    subdivisionInBar_ {subdivisionPosition.second},
+    timeSignatureIndex_ {findLatest(metricStructure.timeSignatureChanges_, bar_)},
+    bpmIndex_ {findLatest(metricStructure.bpmChanges_, MetricPosition(bar_))}
+{
+    updateBeat();
+}
+
+MetricStructure::BeatRange::Iterator& MetricStructure::BeatRange::Iterator::operator++() noexcept
+{
+    const auto& timeSignatureChanges = metricStructure_->timeSignatureChanges_;
+    const auto beatsPerBar = timeSignatureChanges[timeSignatureIndex_].second.top();
+
+    if (++subdivisionInBar_ == static_cast<long long>(beatsPerBar) * subdivision_)
+    {
+        ++bar_;
+        subdivisionInBar_ = 0;
+        timeSignatureIndex_ = advanceLatest(timeSignatureChanges, timeSignatureIndex_, bar_, 1);
+    }
+
+    updateBeat();
+
+    return *this;
+}
+
+MetricStructure::BeatRange::Iterator MetricStructure::BeatRange::Iterator::operator++(int) noexcept
+{
+    auto previous = *this;
+    ++*this;
+
+    return previous;
+}
+
+void MetricStructure::BeatRange::Iterator::updateBeat() noexcept
+{
+    // A beat can pass any number of BPM changes, each of which is stepped through once
+    constexpr auto maxSteps = std::numeric_limits<std::size_t>::max();
+
+    beat_.position = MetricPosition(bar_, reduce(Fraction(subdivisionInBar_, subdivision_)));
+    bpmIndex_ = advanceLatest(metricStructure_->bpmChanges_, bpmIndex_, beat_.position, maxSteps);
+    beat_.seconds = metricStructure_->approximateSecondsWithin(
+        beat_.position, timeSignatureIndex_, bpmIndex_);
+}
+
+MetricStructure::BlockRenderer::BlockRenderer(const MetricStructure& metricStructure,
+                                              const long long sampleRate,
+                                              const long long sample) :
+    metricStructure_ {&metricStructure},
+    sampleRate_ {sampleRate}
+{
+    seek(sample);
+}
+
+void MetricStructure::BlockRenderer::seek(const long long sample)
+{
+    const auto& metricStructure = *metricStructure_;
+    const auto& timeSignatureChanges = metricStructure.timeSignatureChanges_;
+    const auto& bpmChanges = metricStructure.bpmChanges_;
+    const auto seconds = static_cast<double>(sample) / static_cast<double>(sampleRate_);
+
+    sample_ = sample;
+
+    // Step from the start of the bar before the approximate position of the sample, which is
+    // before it however far off the approximation is
+    beat_ = MetricPosition(metricStructure.approximatePositionAt(seconds).bar - 1, 0);
+    timeSignatureIndex_ = findLatest(timeSignatureChanges, beat_.bar);
+    bpmIndex_ = findLatest(bpmChanges, beat_);
+    beatSample_ = sampleAt(beat_, timeSignatureIndex_, bpmIndex_);
+
+    while (beatSample_ < sample)
+        advanceBeat();
+
+    // Likewise from the BPM change before the approximate one
+    const auto bpmChangeIndex = metricStructure.findTempoSegment(seconds);
+    bpmChangeIndex_ = (bpmChangeIndex == 0) ? 0 : bpmChangeIndex - 1;
+    const auto& position = bpmChanges[bpmChangeIndex_].first;
+    bpmChangeSample_ =
+        sampleAt(position, findLatest(timeSignatureChanges, position.bar), bpmChangeIndex_);
+
+    while (bpmChangeSample_ < sample)
+        advanceBpmChange();
+}
+
+long long MetricStructure::BlockRenderer::sampleAt(const MetricPosition& position,
+                                                   const std::size_t timeSignatureIndex,
+                                                   const std::size_t bpmIndex) const
+{
+    const auto& metricStructure = *metricStructure_;
+    const auto& segment = metricStructure.tempoSegments_[bpmIndex];
+
+    const auto isRational =
+        segment.seconds != unknownSeconds
+        && (segment.ramp == TempoRamp::none
+            || !(metricStructure.bpmChanges_[bpmIndex].first < position));
+
+    if (isRational)
+    {
+        const auto seconds = metricStructure.secondsWithin(position, timeSignatureIndex, bpmIndex);
+        return ceil(reduce(seconds * sampleRate_));
+    }
+
+    const auto seconds =
+        metricStructure.approximateSecondsWithin(position, timeSignatureIndex, bpmIndex);
+
+    return static_cast<long long>(std::ceil(seconds * static_cast<double>(sampleRate_)));
+}
+
+void MetricStructure::BlockRenderer::advanceBeat()
+{
+    const auto& metricStructure = *metricStructure_;
+    const auto beatsPerBar = metricStructure.timeSignatureChanges_[timeSignatureIndex_].second.top();
+
+    beat_ = (beat_.beat + 1 < beatsPerBar) ? MetricPosition(beat_.bar, beat_.beat + 1)
+                                           : MetricPosition(beat_.bar + 1, 0);
+
+    // A beat can pass any number of BPM changes, each of which is stepped through once
+    constexpr auto maxSteps = std::numeric_limits<std::size_t>::max();
+
+    timeSignatureIndex_ =
+        advanceLatest(metricStructure.timeSignatureChanges_, timeSignatureIndex_, beat_.bar, 1);
+    bpmIndex_ = advanceLatest(metricStructure.bpmChanges_, bpmIndex_, beat_, maxSteps);
+    beatSample_ = sampleAt(beat_, timeSignatureIndex_, bpmIndex_);
+}
+
+void MetricStructure::BlockRenderer::advanceBpmChange()
+{
+    const auto& metricStructure = *metricStructure_;
+    const auto& bpmChanges = metricStructure.bpmChanges_;
+
+    if (++bpmChangeIndex_ == bpmChanges.size())
+    {
+        bpmChangeSample_ = std::numeric_limits<long long>::max();
+        return;
+    }
+
+    const auto& position = bpmChanges[bpmChangeIndex_].first;
+    const auto timeSignatureIndex = findLatest(metricStructure.timeSignatureChanges_, position.bar);
+
+    bpmChangeSample_ = sampleAt(position, timeSignatureIndex, bpmChangeIndex_);
+}
 
 }; // namespace Cbb
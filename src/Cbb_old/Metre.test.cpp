@@ -3,7 +3,14 @@
 
 #include <Cbb/Metre.hpp>
 
+#include <algorithm>
+#include <cmath>
+#include <iterator>
 #include <sstream>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 
 using namespace Cbb;
@@ -346,3 +353,600 @@ SCENARIO("The BPM at any given position can be found")
         }
     }
 }
+
+SCENARIO("Changes added in any order are kept in ascending order")
+{
+    GIVEN("a metric structure with BPM changes added out of order")
+    {
+        auto metricStructure = MetricStructure(TimeSignature(4, 4), 120);
+        metricStructure.addBpmChange({8, {1, 2}}, 90);
+        metricStructure.addBpmChange(4, 100);
+        metricStructure.addBpmChange({8, {1, 3}}, 80);
+        metricStructure.addBpmChange(16, 60);
+
+        THEN("the BPM changes are listed in ascending order of position")
+        {
+            const auto bpmChanges = metricStructure.bpmChanges();
+
+            REQUIRE(bpmChanges.size() == 5);
+            REQUIRE(std::is_sorted(
+                bpmChanges.begin(), bpmChanges.end(), [](const auto& left, const auto& right) {
+                    return left.first < right.first;
+                }));
+            REQUIRE(bpmChanges.front().first == 0);
+            REQUIRE(bpmChanges[2].first == MetricPosition(8, {1, 3}));
+            REQUIRE(bpmChanges.back().second == 60);
+        }
+
+        WHEN("a BPM change is added at a position that already has one")
+        {
+            metricStructure.addBpmChange(4, 104);
+
+            THEN("the BPM change is replaced")
+            {
+                REQUIRE(metricStructure.bpmChanges().size() == 5);
+                REQUIRE(metricStructure.lastestBpmChange({6, {1, 4}}).second == 104);
+            }
+        }
+
+        THEN("the latest BPM change is found between and on the changes")
+        {
+            REQUIRE(metricStructure.lastestBpmChange({8, {1, 3}}).second == 80);
+            REQUIRE(metricStructure.lastestBpmChange({8, {2, 5}}).second == 80);
+            REQUIRE(metricStructure.lastestBpmChange({8, {1, 2}}).second == 90);
+            REQUIRE(metricStructure.lastestBpmChange(1000).second == 60);
+        }
+
+        THEN("the latest BPM change for a position before the initial bar is the initial change")
+        {
+            REQUIRE(metricStructure.lastestBpmChange(-3).first == 0);
+        }
+    }
+}
+
+SCENARIO("Changes can be assigned in bulk")
+{
+    GIVEN("a metric structure with changes added one at a time")
+    {
+        auto metricStructure = MetricStructure(TimeSignature(4, 4), 120);
+        metricStructure.addTimeSignatureChange(9, TimeSignature(5, 4));
+        metricStructure.addBpmChange(50, 60);
+
+        const auto timeSignatureChanges = std::vector<std::pair<BarNumber, TimeSignature>>(
+            {{12, {7, 8}}, {3, {3, 4}}, {20, {4, 4}}, {12, {6, 8}}});
+        const auto bpmChanges = std::vector<std::pair<MetricPosition, TempoBpm>>(
+            {{{8, {1, 2}}, 90}, {4, 100}, {16, 60}, {{8, {1, 3}}, 80}, {4, 104}});
+
+        auto added = MetricStructure(TimeSignature(4, 4), 120);
+
+        for (const auto& [bar, timeSignature] : timeSignatureChanges)
+            added.addTimeSignatureChange(bar, timeSignature);
+
+        for (const auto& [position, bpm] : bpmChanges)
+            added.addBpmChange(position, bpm);
+
+        WHEN("changes in any order are assigned")
+        {
+            metricStructure.assignTimeSignatureChanges(timeSignatureChanges);
+            metricStructure.assignBpmChanges(bpmChanges.begin(), bpmChanges.end());
+
+            THEN("they replace the changes as if each had been added in turn")
+            {
+                REQUIRE(std::equal(metricStructure.timeSignatureChanges().begin(),
+                                   metricStructure.timeSignatureChanges().end(),
+                                   added.timeSignatureChanges().begin(),
+                                   added.timeSignatureChanges().end()));
+                REQUIRE(std::equal(metricStructure.bpmChanges().begin(),
+                                   metricStructure.bpmChanges().end(),
+                                   added.bpmChanges().begin(),
+                                   added.bpmChanges().end()));
+            }
+
+            THEN("the last of the changes at the same bar or position is kept")
+            {
+                REQUIRE(metricStructure.lastestTimeSignatureChange(13).second
+                        == TimeSignature(6, 8));
+                REQUIRE(metricStructure.lastestBpmChange(5).second == 104);
+            }
+
+            THEN("the derived tables are rebuilt")
+            {
+                for (const auto& position :
+                     {MetricPosition(0), MetricPosition(5, 1), MetricPosition(13, {5, 2}),
+                      MetricPosition(30)})
+                {
+                    REQUIRE(metricStructure.secondsAt(position) == added.secondsAt(position));
+                    REQUIRE(metricStructure.offsetOf(position) == added.offsetOf(position));
+                }
+            }
+        }
+
+        WHEN("an empty range is assigned")
+        {
+            metricStructure.assignTimeSignatureChanges(
+                std::vector<std::pair<BarNumber, TimeSignature>>());
+            metricStructure.assignBpmChanges(std::vector<std::pair<MetricPosition, TempoBpm>>());
+
+            THEN("only the initial changes remain")
+            {
+                REQUIRE(metricStructure.timeSignatureChanges().size() == 1);
+                REQUIRE(metricStructure.bpmChanges().size() == 1);
+                REQUIRE(metricStructure.secondsAt(10) == 20);
+            }
+        }
+
+        WHEN("BPM changes with ramps are assigned")
+        {
+            metricStructure.assignBpmChanges(
+                std::vector<std::tuple<MetricPosition, TempoBpm, TempoRamp>>(
+                    {{1, 120, TempoRamp::none}, {0, 60, TempoRamp::linear}}));
+
+            THEN("the ramps are kept with their changes")
+            {
+                REQUIRE(metricStructure.lastestBpmRamp({0, 2}) == TempoRamp::linear);
+                REQUIRE(metricStructure.lastestBpmRamp(2) == TempoRamp::none);
+                REQUIRE(metricStructure.secondsAt(1) == Fraction(8, 3));
+            }
+        }
+    }
+}
+
+SCENARIO("The seconds at any given position can be found")
+{
+    GIVEN("a metric structure in 4/4 at 120 BPM")
+    {
+        auto metricStructure = MetricStructure(TimeSignature(4, 4), 120);
+
+        THEN("every beat lasts half a second")
+        {
+            REQUIRE(metricStructure.secondsAt(0) == 0);
+            REQUIRE(metricStructure.secondsAt(1) == 2);
+            REQUIRE(metricStructure.secondsAt({2, {1, 2}}) == Fraction(17, 4));
+        }
+
+        WHEN("a BPM change to 60 is added at bar 2")
+        {
+            metricStructure.addBpmChange(2, 60);
+
+            THEN("the beats after it last a second")
+            {
+                REQUIRE(metricStructure.secondsAt(2) == 4);
+                REQUIRE(metricStructure.secondsAt({3, 1}) == 9);
+            }
+
+            AND_WHEN("a time signature change to 3/4 is added at bar 1")
+            {
+                metricStructure.addTimeSignatureChange(1, TimeSignature(3, 4));
+
+                THEN("the BPM change and the positions after it move a beat earlier")
+                {
+                    REQUIRE(metricStructure.secondsAt(2) == Fraction(7, 2));
+                    REQUIRE(metricStructure.secondsAt({3, 1}) == Fraction(15, 2));
+                }
+
+                AND_WHEN("the time signature change is erased")
+                {
+                    metricStructure.eraseTimeSignatureChangeAt(1);
+
+                    THEN("the seconds are as they were")
+                    {
+                        REQUIRE(metricStructure.secondsAt({3, 1}) == 9);
+                    }
+                }
+            }
+
+            AND_WHEN("a BPM change to 150 1/2 is added before it")
+            {
+                metricStructure.addBpmChange({1, 3}, MixedFraction(150, {1, 2}));
+
+                THEN("the seconds are exact")
+                {
+                    REQUIRE(metricStructure.secondsAt({1, 3}) == Fraction(7, 2));
+                    REQUIRE(metricStructure.secondsAt(2) == Fraction(7, 2) + Fraction(120, 301));
+                    REQUIRE(metricStructure.secondsAt({3, 1})
+                            == Fraction(7, 2) + Fraction(120, 301) + 5);
+                }
+            }
+        }
+    }
+
+    GIVEN("a metric structure with several time signature and BPM changes")
+    {
+        auto metricStructure = MetricStructure(TimeSignature(4, 4), 120);
+        metricStructure.addTimeSignatureChange(3, TimeSignature(7, 8));
+        metricStructure.addTimeSignatureChange(9, TimeSignature(5, 4));
+        metricStructure.addBpmChange({2, {3, 2}}, MixedFraction(97, {1, 3}));
+        metricStructure.addBpmChange({9, 4}, 72);
+
+        const auto positions = std::vector<MetricPosition>(
+            {-1, 0, {1, {1, 3}}, {2, {3, 2}}, {4, 6}, 9, {9, {9, 2}}, {12, {1, 7}}});
+
+        THEN("the seconds of ascending positions found at once match those found one by one")
+        {
+            auto seconds = std::vector<Fraction>();
+            metricStructure.secondsAt(
+                positions.begin(), positions.end(), std::back_inserter(seconds));
+
+            REQUIRE(seconds.size() == positions.size());
+
+            for (std::size_t i = 0; i < positions.size(); ++i)
+                REQUIRE(seconds[i] == metricStructure.secondsAt(positions[i]));
+        }
+
+        THEN("the approximate seconds are close to the exact seconds")
+        {
+            for (const auto& position : positions)
+                REQUIRE(metricStructure.approximateSecondsAt(position)
+                        == Approx(toDecimal(metricStructure.secondsAt(position))));
+        }
+
+        THEN("the position at the seconds of each position is that position")
+        {
+            for (const auto& position : positions)
+                REQUIRE(metricStructure.positionAt(metricStructure.secondsAt(position))
+                        == position);
+        }
+
+        THEN("a cursor moved through the positions, and back, finds the same changes and seconds")
+        {
+            auto cursor = metricStructure.cursor(positions.front());
+
+            const auto requireAgreement = [&](const MetricPosition& position) {
+                cursor.moveTo(position);
+
+                REQUIRE(cursor.position() == position);
+                REQUIRE(cursor.lastestTimeSignatureChange()
+                        == metricStructure.lastestTimeSignatureChange(position));
+                REQUIRE(cursor.lastestBpmChange() == metricStructure.lastestBpmChange(position));
+                REQUIRE(cursor.seconds() == metricStructure.secondsAt(position));
+                REQUIRE(cursor.approximateSeconds()
+                        == Approx(metricStructure.approximateSecondsAt(position)));
+            };
+
+            for (const auto& position : positions)
+                requireAgreement(position);
+
+            requireAgreement({2, {1, 5}});
+            requireAgreement({9, {9, 2}});
+
+            for (BarNumber bar = -2; bar < 14; ++bar)
+                requireAgreement({bar, {1, 2}});
+        }
+
+        THEN("a position stream finds the same positions, also after going back in time")
+        {
+            auto stream = metricStructure.positionStream();
+
+            for (const auto& position : positions)
+                REQUIRE(stream.positionAt(metricStructure.secondsAt(position)) == position);
+
+            REQUIRE(stream.positionAt(metricStructure.secondsAt({2, {1, 5}}))
+                    == MetricPosition(2, {1, 5}));
+            REQUIRE(stream.positionAt(metricStructure.secondsAt({9, {9, 2}}))
+                    == MetricPosition(9, {9, 2}));
+        }
+    }
+}
+
+SCENARIO("The tempo can ramp from one BPM change to the next")
+{
+    GIVEN("a metric structure in 4/4 with a linear ramp from 60 BPM at bar 0 to 120 BPM at bar 1")
+    {
+        auto metricStructure = MetricStructure(TimeSignature(4, 4), 60);
+        metricStructure.addBpmChange(0, 60, TempoRamp::linear);
+        metricStructure.addBpmChange(1, 120);
+
+        THEN("the ramp lasts as long as its mean tempo would, exactly")
+        {
+            REQUIRE(metricStructure.lastestBpmRamp({0, 2}) == TempoRamp::linear);
+            REQUIRE(metricStructure.secondsAt(1) == Fraction(8, 3));
+            REQUIRE(metricStructure.secondsAt({2, 1}) == Fraction(8, 3) + Fraction(5, 2));
+            REQUIRE(metricStructure.approximateSecondsAt({2, 1}) == Approx(8.0 / 3 + 2.5));
+        }
+
+        THEN("the beats within it are exact, but the seconds are not")
+        {
+            REQUIRE(metricStructure.positionAt(1) == MetricPosition(0, {19, 16}));
+            REQUIRE(metricStructure.positionAt(Fraction(11, 3)) == MetricPosition(1, 2));
+            REQUIRE_THROWS_AS(metricStructure.secondsAt({0, 1}), std::domain_error);
+            REQUIRE(metricStructure.secondsAt(0) == 0);
+        }
+
+        THEN("the approximate queries integrate it")
+        {
+            REQUIRE(metricStructure.approximateSecondsAt({0, {19, 16}}) == Approx(1));
+            REQUIRE(metricStructure.approximatePositionAt(1) == MetricPosition(0, {19, 16}));
+            REQUIRE(metricStructure.approximateBpmAt(0) == Approx(60));
+            REQUIRE(metricStructure.approximateBpmAt({0, 2}) == Approx(60 * std::sqrt(2.5)));
+            REQUIRE(metricStructure.approximateBpmAt(1) == Approx(120));
+        }
+
+        WHEN("the BPM change at bar 1 is erased")
+        {
+            metricStructure.eraseBpmChangeAt(1);
+
+            THEN("the ramp has no effect")
+            {
+                REQUIRE(metricStructure.secondsAt({1, 2}) == 6);
+                REQUIRE(metricStructure.approximateSecondsAt({1, 2}) == Approx(6));
+            }
+        }
+    }
+
+    GIVEN("a metric structure in 4/4 with an exponential ramp from 60 BPM to 120 BPM at bar 1")
+    {
+        auto metricStructure = MetricStructure(TimeSignature(4, 4), 60);
+        metricStructure.addBpmChange(0, 60, TempoRamp::exponential);
+        metricStructure.addBpmChange(1, 120);
+
+        const auto rampSeconds = 4 * std::log(2.0);
+
+        THEN("the ramp lasts an irrational number of seconds")
+        {
+            REQUIRE(metricStructure.secondsAt(0) == 0);
+            REQUIRE_THROWS_AS(metricStructure.secondsAt({0, 1}), std::domain_error);
+            REQUIRE_THROWS_AS(metricStructure.secondsAt({1, 1}), std::domain_error);
+            REQUIRE_THROWS_AS(metricStructure.positionAt(1), std::domain_error);
+            REQUIRE_THROWS_AS(metricStructure.positionAt(5), std::domain_error);
+        }
+
+        THEN("the approximate queries integrate it")
+        {
+            REQUIRE(metricStructure.approximateSecondsAt(1) == Approx(rampSeconds));
+            REQUIRE(metricStructure.approximateSecondsAt({1, 2}) == Approx(rampSeconds + 1));
+            REQUIRE(metricStructure.approximatePositionAt(rampSeconds + 1) == MetricPosition(1, 2));
+            REQUIRE(metricStructure.approximateBpmAt({0, 2}) == Approx(90));
+        }
+    }
+
+    GIVEN("a linear and an exponential ramp, and the same ramps in 100 steps a beat")
+    {
+        auto metricStructure = MetricStructure(TimeSignature(3, 4), 72);
+        metricStructure.addBpmChange(1, 72, TempoRamp::linear);
+        metricStructure.addBpmChange(3, 144, TempoRamp::exponential);
+        metricStructure.addBpmChange(5, 90);
+
+        auto steps = MetricStructure(TimeSignature(3, 4), 72);
+
+        // Each step takes the BPM halfway through it
+        for (auto step = 0; step < 1200; ++step)
+        {
+            const auto bar = BarNumber(1 + step / 300);
+            const auto middle = MetricPosition(bar, {2 * (step % 300) + 1, 200});
+            const auto bpm = std::llround(metricStructure.approximateBpmAt(middle) * 1000);
+
+            steps.addBpmChange({bar, {step % 300, 100}}, Fraction(bpm, 1000));
+        }
+
+        steps.addBpmChange(5, 90);
+
+        THEN("their seconds agree")
+        {
+            for (const auto bar : {1, 2, 3, 4, 5, 6})
+                REQUIRE(metricStructure.approximateSecondsAt(bar)
+                        == Approx(steps.approximateSecondsAt(bar)).epsilon(1e-5));
+        }
+    }
+}
+
+SCENARIO("The beats between two positions can be iterated")
+{
+    GIVEN("a metric structure in 4/4 at 120 BPM with a change to 3/4 at bar 1")
+    {
+        auto metricStructure = MetricStructure(TimeSignature(4, 4), 120);
+        metricStructure.addTimeSignatureChange(1, TimeSignature(3, 4));
+
+        THEN("the beats follow the time signatures, with their seconds")
+        {
+            const auto range = metricStructure.beats(0, 3);
+            const auto beats =
+                std::vector<MetricStructure::BeatRange::Beat>(range.begin(), range.end());
+
+            REQUIRE(beats.size() == 10);
+            REQUIRE(beats[3].position == MetricPosition(0, 3));
+            REQUIRE(beats[4].position == MetricPosition(1));
+            REQUIRE(beats[9].position == MetricPosition(2, 2));
+
+            for (const auto& beat : beats)
+                REQUIRE(beat.seconds == Approx(toDecimal(metricStructure.secondsAt(beat.position))));
+        }
+
+        THEN("the beats can be subdivided, from and to positions between them")
+        {
+            auto positions = std::vector<MetricPosition>();
+
+            for (const auto& beat : metricStructure.beats({0, {1, 3}}, {1, 1}, 2))
+                positions.push_back(beat.position);
+
+            REQUIRE(positions.size() == 9);
+            REQUIRE(positions.front() == MetricPosition(0, {1, 2}));
+            REQUIRE(positions[6] == MetricPosition(0, {7, 2}));
+            REQUIRE(positions.back() == MetricPosition(1, {1, 2}));
+        }
+
+        THEN("a position past the end of its bar ends the range at the next bar")
+        {
+            const auto beats = metricStructure.beats({0, 2}, {0, 5});
+
+            REQUIRE(std::distance(beats.begin(), beats.end()) == 2);
+        }
+
+        THEN("the range is empty from a position at or after the end")
+        {
+            const auto beats = metricStructure.beats(2, {1, 1});
+
+            REQUIRE(beats.begin() == beats.end());
+            REQUIRE(metricStructure.beats(2, 2).begin() == metricStructure.beats(2, 2).end());
+        }
+
+        THEN("the subdivision must be positive")
+        {
+            REQUIRE_THROWS_AS(metricStructure.beats(0, 1, 0), std::invalid_argument);
+        }
+    }
+}
+
+SCENARIO("The bar lines, beats and BPM changes within blocks of samples can be found")
+{
+    using Event = MetricStructure::BlockRenderer::Event;
+
+    // The events of consecutive blocks up to the end sample, with their samples from the start
+    const auto render = [](MetricStructure::BlockRenderer renderer,
+                           const long long blockSize,
+                           const long long end) {
+        auto events = std::vector<Event>();
+
+        while (renderer.sample() < end)
+        {
+            const auto first = events.size();
+            const auto blockStart = renderer.sample();
+            renderer.render(std::min(blockSize, end - blockStart), std::back_inserter(events));
+
+            for (auto i = first; i < events.size(); ++i)
+                events[i].sampleOffset += blockStart;
+        }
+
+        return events;
+    };
+
+    GIVEN("a metric structure in 4/4 at 120 BPM with a change to 90 BPM on the third beat of bar 1")
+    {
+        auto metricStructure = MetricStructure(TimeSignature(4, 4), 120);
+        metricStructure.addBpmChange({1, 2}, 90);
+
+        THEN("the events of blocks at 48 kHz, from the initial BPM change, are at the samples of "
+             "their seconds")
+        {
+            const auto events = render(metricStructure.blockRenderer(48'000), 64, 200'000);
+
+            REQUIRE(events.size() == 10);
+            REQUIRE(events[0].kind == Event::Kind::bar);
+            REQUIRE(events[0].sampleOffset == 0);
+            REQUIRE(events[1].kind == Event::Kind::bpmChange);
+            REQUIRE(events[1].sampleOffset == 0);
+            REQUIRE(events[4].position == MetricPosition(0, 3));
+            REQUIRE(events[4].sampleOffset == 72'000);
+            REQUIRE(events[5].kind == Event::Kind::bar);
+            REQUIRE(events[5].position == MetricPosition(1));
+            REQUIRE(events[7].kind == Event::Kind::beat);
+            REQUIRE(events[7].sampleOffset == 144'000);
+            REQUIRE(events[8].kind == Event::Kind::bpmChange);
+            REQUIRE(events[8].position == MetricPosition(1, 2));
+            REQUIRE(events[8].sampleOffset == 144'000);
+            REQUIRE(events[9].position == MetricPosition(1, 3));
+            REQUIRE(events[9].sampleOffset == 176'000);
+        }
+
+        THEN("the events do not depend on the size of the blocks")
+        {
+            const auto events = render(metricStructure.blockRenderer(48'000), 64, 500'000);
+
+            REQUIRE(render(metricStructure.blockRenderer(48'000), 1000, 500'000).size()
+                    == events.size());
+            REQUIRE(render(metricStructure.blockRenderer(48'000), 500'000, 500'000).back().position
+                    == events.back().position);
+        }
+
+        THEN("rendering can start at any sample")
+        {
+            const auto events = render(metricStructure.blockRenderer(48'000, 100'000), 64, 150'000);
+
+            REQUIRE(events.size() == 3);
+            REQUIRE(events[0].position == MetricPosition(1, 1));
+            REQUIRE(events[0].sampleOffset == 120'000);
+        }
+
+        THEN("the sample rate must be positive")
+        {
+            REQUIRE_THROWS_AS(metricStructure.blockRenderer(0), std::invalid_argument);
+        }
+    }
+
+    GIVEN("a metric structure with fractional BPMs and time signature changes")
+    {
+        auto metricStructure = MetricStructure(TimeSignature(7, 8), MixedFraction(97, {1, 3}));
+        metricStructure.addTimeSignatureChange(13, TimeSignature(5, 4));
+        metricStructure.addBpmChange({20, {1, 2}}, MixedFraction(131, {2, 7}));
+        metricStructure.addBpmChange(45, 60);
+
+        THEN("every event over ten minutes at 44.1 kHz is at the first sample at or after it")
+        {
+            const auto events = render(metricStructure.blockRenderer(44'100), 512, 26'460'000);
+
+            REQUIRE(events.size() > 700);
+
+            for (const auto& event : events)
+                REQUIRE(event.sampleOffset
+                        == ceil(metricStructure.secondsAt(event.position) * 44'100));
+        }
+    }
+
+    GIVEN("a linear ramp from 60 BPM at bar 0 to 120 BPM at bar 1")
+    {
+        auto metricStructure = MetricStructure(TimeSignature(4, 4), 60);
+        metricStructure.addBpmChange(0, 60, TempoRamp::linear);
+        metricStructure.addBpmChange(1, 120);
+
+        THEN("the beats within it are approximate, and those after it exact")
+        {
+            const auto events = render(metricStructure.blockRenderer(48'000), 64, 200'000);
+
+            REQUIRE(events[2].position == MetricPosition(0, 1));
+            REQUIRE(events[2].sampleOffset
+                    == Approx(metricStructure.approximateSecondsAt({0, 1}) * 48'000).margin(1));
+            REQUIRE(events[5].position == MetricPosition(1));
+            REQUIRE(events[5].sampleOffset == 128'000);
+            REQUIRE(events[6].kind == Event::Kind::bpmChange);
+            REQUIRE(events[7].sampleOffset == 152'000);
+        }
+    }
+}
+
+SCENARIO("The offset in whole notes of any given position can be found")
+{
+    GIVEN("a metric structure from bar 1 in 4/4, with changes to 6/8 at bar 3 and 5/4 at bar 5")
+    {
+        auto metricStructure = MetricStructure(TimeSignature(4, 4), 120, 1);
+        metricStructure.addTimeSignatureChange(3, TimeSignature(6, 8));
+        metricStructure.addTimeSignatureChange(5, TimeSignature(5, 4));
+
+        THEN("the offsets count the whole notes of the bars from the initial bar")
+        {
+            REQUIRE(metricStructure.offsetOf(1) == 0);
+            REQUIRE(metricStructure.offsetOf({2, 2}) == Fraction(3, 2));
+            REQUIRE(metricStructure.offsetOf(3) == 2);
+            REQUIRE(metricStructure.offsetOf({3, 3}) == Fraction(19, 8));
+            REQUIRE(metricStructure.offsetOf(5) == Fraction(7, 2));
+            REQUIRE(metricStructure.offsetOf({6, 1}) == 5);
+            REQUIRE(metricStructure.offsetOf({0, 2}) == Fraction(-1, 2));
+        }
+
+        THEN("the duration between positions across time signature changes is the difference of "
+             "their offsets")
+        {
+            REQUIRE(metricStructure.offsetOf({6, 1}) - metricStructure.offsetOf({2, 2})
+                    == Fraction(7, 2));
+        }
+
+        THEN("the position at the offset of each position is that position")
+        {
+            const auto positions = std::vector<MetricPosition>(
+                {{-2, 3}, 1, {2, {7, 3}}, 3, {4, {11, 2}}, {5, {1, 5}}, {40, 4}});
+
+            for (const auto& position : positions)
+                REQUIRE(metricStructure.positionAtOffset(metricStructure.offsetOf(position))
+                        == position);
+        }
+
+        WHEN("the time signature change at bar 3 is erased")
+        {
+            metricStructure.eraseTimeSignatureChangeAt(3);
+
+            THEN("the bars up to bar 5 are in 4/4")
+            {
+                REQUIRE(metricStructure.offsetOf(5) == 4);
+                REQUIRE(metricStructure.positionAtOffset(Fraction(17, 4)) == MetricPosition(5, 1));
+            }
+        }
+    }
+}
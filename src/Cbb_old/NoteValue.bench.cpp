@@ -0,0 +1,178 @@
+#define CATCH_CONFIG_MAIN
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include <catch2/catch.hpp>
+
+#include <Cbb/NoteValue.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+
+namespace {
+
+
+std::atomic<std::size_t> numAllocations {0};
+
+
+} // namespace
+
+
+// Counts every allocation in the program, so that a benchmark can check how many its loop makes
+void* operator new(const std::size_t size)
+{
+    ++numAllocations;
+
+    if (auto* const pointer = std::malloc(size == 0 ? 1 : size))
+        return pointer;
+
+    throw std::bad_alloc();
+}
+
+void operator delete(void* const pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void* const pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+
+using namespace Cbb;
+
+
+namespace {
+
+
+// The single note values and short ties that make up almost every part
+std::vector<NoteValue> makeNoteValues(const std::size_t size)
+{
+    const auto pattern = {NoteValue(eighthNote, 1),
+                          NoteValue(sixteenthNote),
+                          NoteValue(eighthNote, triplet),
+                          NoteValue(quarterNote),
+                          NoteValue(halfNote, 2)};
+
+    auto noteValues = std::vector<NoteValue>();
+    noteValues.reserve(size);
+
+    while (noteValues.size() < size)
+        for (const auto& noteValue : pattern)
+            noteValues.push_back(noteValue);
+
+    noteValues.resize(size);
+
+    return noteValues;
+}
+
+// Builds one composite per note value: singles, then pairs and triples of ties
+template <typename Composites>
+void buildComposites(const std::vector<NoteValue>& noteValues, Composites& composites)
+{
+    for (std::size_t i = 0; i < noteValues.size(); ++i)
+    {
+        auto& composite = composites[i];
+        composite = CompositeNoteValue(noteValues[i]);
+
+        for (std::size_t j = 1; j <= i % 3 && i + j < noteValues.size(); ++j)
+            composite.append(noteValues[i + j]);
+    }
+}
+
+
+} // namespace
+
+
+TEST_CASE("Building and copying 10^6 composite note values", "[NoteValue][benchmark]")
+{
+    const auto noteValues = makeNoteValues(1'000'000);
+
+    auto composites = std::vector<CompositeNoteValue>(noteValues.size());
+    auto copies = std::vector<CompositeNoteValue>(noteValues.size());
+
+    const auto allocationsBefore = numAllocations.load();
+
+    buildComposites(noteValues, composites);
+    std::copy(composites.begin(), composites.end(), copies.begin());
+
+    const auto allocations = numAllocations.load() - allocationsBefore;
+
+    WARN("Allocations building and copying " << composites.size()
+                                             << " composites of 1 to 3 note values: "
+                                             << allocations);
+    CHECK(allocations == 0);
+
+    BENCHMARK("build")
+    {
+        buildComposites(noteValues, composites);
+        return composites.size();
+    };
+
+    BENCHMARK("copy")
+    {
+        std::copy(composites.begin(), composites.end(), copies.begin());
+        return copies.size();
+    };
+
+    BENCHMARK("relativeValue")
+    {
+        auto total = FractionAccumulator();
+
+        for (const auto& composite : composites)
+            total += relativeValue(composite);
+
+        return total.total();
+    };
+}
+
+TEST_CASE("Sorting 10^5 composite note values", "[NoteValue][benchmark]")
+{
+    const auto noteValues = makeNoteValues(100'000 + 8);
+
+    // Ties of 1 to 8 note values, so that most of them have spilled to the heap
+    auto composites = std::vector<CompositeNoteValue>(noteValues.size() - 8);
+
+    for (std::size_t i = 0; i < composites.size(); ++i)
+    {
+        composites[i] = CompositeNoteValue(noteValues[i]);
+
+        for (std::size_t j = 1; j <= i % 8; ++j)
+            composites[i] += noteValues[i + j];
+    }
+
+    const auto summedLess = [](const CompositeNoteValue& left, const CompositeNoteValue& right) {
+        const auto sum = [](const CompositeNoteValue& value) {
+            auto total = FractionAccumulator();
+
+            for (const auto& noteValue : value)
+                total += noteValue.relativeValue();
+
+            return total.total();
+        };
+
+        return sum(left) < sum(right);
+    };
+
+    auto sorted = composites;
+    std::sort(sorted.begin(), sorted.end());
+
+    CHECK(std::is_sorted(sorted.begin(), sorted.end(), summedLess));
+
+    BENCHMARK("std::sort summing the note values on every comparison")
+    {
+        auto copy = composites;
+        std::sort(copy.begin(), copy.end(), summedLess);
+        return copy.size();
+    };
+
+    BENCHMARK("std::sort by operator< (cached relative values)")
+    {
+        auto copy = composites;
+        std::sort(copy.begin(), copy.end());
+        return copy.size();
+    };
+}
@@ -1,8 +1,9 @@
 #include <Cbb/NoteValue.hpp>
 
 #include <algorithm>
-#include <functional>
+#include <numeric>
 #include <stdexcept>
+#include <utility>
 
 
 namespace Cbb {
@@ -13,18 +14,59 @@ CompositeNoteValue::CompositeNoteValue(const NoteValueBase base) :
 {
 }
 
-CompositeNoteValue::CompositeNoteValue(const NoteValue& value) : values_ {value} {}
+CompositeNoteValue::CompositeNoteValue(const NoteValue& value) :
+    inlineValues_ {value},
+    relativeValue_ {reduce(value.relativeValue())}
+{
+}
 
 CompositeNoteValue::CompositeNoteValue(const std::initializer_list<NoteValue> values) :
-    values_ {values}
+    size_ {values.size()}
 {
     if (values.size() == 0)
         throw std::invalid_argument("a composite note value cannot be empty");
+
+    if (values.size() <= inlineCapacity)
+        std::copy(values.begin(), values.end(), inlineValues_.begin());
+    else
+        heapValues_.assign(values.begin(), values.end());
+
+    relativeValue_ = std::accumulate(values.begin(),
+                                     values.end(),
+                                     FractionAccumulator(),
+                                     [](FractionAccumulator sum, const NoteValue& value) {
+                                         return sum += value.relativeValue();
+                                     })
+                         .total();
+}
+
+CompositeNoteValue::CompositeNoteValue(CompositeNoteValue&& other) noexcept :
+    inlineValues_ {other.inlineValues_},
+    heapValues_ {std::move(other.heapValues_)},
+    size_ {other.size_},
+    relativeValue_ {other.relativeValue_}
+{
+    other.reset();
+}
+
+CompositeNoteValue& CompositeNoteValue::operator=(CompositeNoteValue&& other) noexcept
+{
+    if (this != &other)
+    {
+        inlineValues_ = other.inlineValues_;
+        heapValues_ = std::move(other.heapValues_);
+        size_ = other.size_;
+        relativeValue_ = other.relativeValue_;
+
+        other.reset();
+    }
+
+    return *this;
 }
 
 CompositeNoteValue& CompositeNoteValue::append(const CompositeNoteValue& value)
 {
-    values_.insert(values_.end(), value.values_.begin(), value.values_.end());
+    insert(size_, value);
     return *this;
 }
 
@@ -35,27 +77,176 @@ CompositeNoteValue& CompositeNoteValue::operator+=(const CompositeNoteValue& val
 
 CompositeNoteValue& CompositeNoteValue::prepend(const CompositeNoteValue& value)
 {
-    values_.insert(values_.begin(), value.values_.begin(), value.values_.end());
+    insert(0, value);
     return *this;
 }
 
 const NoteValue& CompositeNoteValue::operator[](const std::size_t index) const
 {
-    return values_[index];
+    return data()[index];
+}
+
+CompositeNoteValue::Reference CompositeNoteValue::operator[](const std::size_t index)
+{
+    return Reference(*this, index);
+}
+
+CompositeNoteValue::Iterator CompositeNoteValue::begin() noexcept
+{
+    return Iterator(*this, 0);
+}
+
+CompositeNoteValue::Iterator CompositeNoteValue::end() noexcept
+{
+    return Iterator(*this, size_);
+}
+
+CompositeNoteValue::ReverseIterator CompositeNoteValue::rbegin() noexcept
+{
+    return ReverseIterator(end());
+}
+
+CompositeNoteValue::ReverseIterator CompositeNoteValue::rend() noexcept
+{
+    return ReverseIterator(begin());
+}
+
+const NoteValue* CompositeNoteValue::data() const noexcept
+{
+    return isInline() ? inlineValues_.data() : heapValues_.data();
+}
+
+NoteValue* CompositeNoteValue::data() noexcept
+{
+    return isInline() ? inlineValues_.data() : heapValues_.data();
+}
+
+void CompositeNoteValue::insert(const std::size_t index, const CompositeNoteValue& value)
+{
+    // Inserting a composite into itself would read values as they are shifted
+    if (&value == this)
+    {
+        const auto copy = value;
+        insert(index, copy);
+        return;
+    }
+
+    const auto newSize = size_ + value.size_;
+
+    if (isInline() && newSize <= inlineCapacity)
+    {
+        const auto position = inlineValues_.begin() + index;
+        const auto last = inlineValues_.begin() + size_;
+
+        std::copy_backward(position, last, last + value.size_);
+        std::copy(value.begin(), value.end(), position);
+    }
+    else
+    {
+        if (isInline())
+        {
+            heapValues_.reserve(newSize);
+            heapValues_.assign(inlineValues_.begin(), inlineValues_.begin() + size_);
+        }
+
+        heapValues_.insert(heapValues_.begin() + index, value.begin(), value.end());
+    }
+
+    size_ = newSize;
+    relativeValue_ = reduce(boundedSum(relativeValue_, value.relativeValue_));
+}
+
+void CompositeNoteValue::replace(const std::size_t index, const NoteValue& value) noexcept
+{
+    auto& current = data()[index];
+
+    const auto withoutCurrent = boundedDifference(relativeValue_, current.relativeValue());
+
+    relativeValue_ = reduce(boundedSum(withoutCurrent, value.relativeValue()));
+    current = value;
 }
 
-NoteValue& CompositeNoteValue::operator[](const std::size_t index)
+void CompositeNoteValue::reset() noexcept
 {
-    return values_[index];
+    // A moved-from vector is valid but unspecified, and an empty one is what marks inline storage
+    heapValues_.clear();
+    inlineValues_ = {};
+    size_ = 1;
+    relativeValue_ = reduce(NoteValue().relativeValue());
+}
+
+CompositeNoteValue::Reference::Reference(CompositeNoteValue& owner,
+                                         const std::size_t index) noexcept :
+    owner_ {&owner},
+    index_ {index}
+{
+}
+
+CompositeNoteValue::Reference&
+CompositeNoteValue::Reference::operator=(const NoteValue& value) noexcept
+{
+    owner_->replace(index_, value);
+    return *this;
+}
+
+CompositeNoteValue::Reference&
+CompositeNoteValue::Reference::operator=(const Reference& other) noexcept
+{
+    return *this = other.get();
+}
+
+void swap(CompositeNoteValue::Reference left, CompositeNoteValue::Reference right) noexcept
+{
+    const auto value = NoteValue(left);
+
+    left = right;
+    right = value;
+}
+
+CompositeNoteValue::Iterator::Iterator(CompositeNoteValue& owner,
+                                       const std::size_t index) noexcept :
+    owner_ {&owner},
+    index_ {index}
+{
+}
+
+CompositeNoteValue::Iterator& CompositeNoteValue::Iterator::operator++() noexcept
+{
+    ++index_;
+    return *this;
+}
+
+CompositeNoteValue::Iterator CompositeNoteValue::Iterator::operator++(int) noexcept
+{
+    auto previous = *this;
+    ++index_;
+    return previous;
+}
+
+CompositeNoteValue::Iterator& CompositeNoteValue::Iterator::operator--() noexcept
+{
+    --index_;
+    return *this;
+}
+
+CompositeNoteValue::Iterator CompositeNoteValue::Iterator::operator--(int) noexcept
+{
+    auto previous = *this;
+    --index_;
+    return previous;
+}
+
+CompositeNoteValue::Iterator&
+CompositeNoteValue::Iterator::operator+=(const difference_type n) noexcept
+{
+    index_ = static_cast<std::size_t>(static_cast<difference_type>(index_) + n);
+    return *this;
 }
 
-Fraction CompositeNoteValue::relativeValue() const noexcept
+CompositeNoteValue::Iterator&
+CompositeNoteValue::Iterator::operator-=(const difference_type n) noexcept
 {
-    return std::transform_reduce(values_.begin(),
-                                 values_.end(),
-                                 Fraction(),
-                                 std::plus<Fraction>(),
-                                 std::mem_fn(&NoteValue::relativeValue));
+    return *this += -n;
 }
 
 Fraction relativeValue(const CompositeNoteValue& value) noexcept
@@ -65,7 +256,7 @@ Fraction relativeValue(const CompositeNoteValue& value) noexcept
 
 CompositeNoteValue::Type CompositeNoteValue::type() const noexcept
 {
-    return (values_.size() > 1) ? tied : single;
+    return (size_ > 1) ? tied : single;
 }
 
 bool operator==(const CompositeNoteValue& left, const CompositeNoteValue& right) noexcept
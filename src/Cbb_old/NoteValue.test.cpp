@@ -3,6 +3,10 @@
 
 #include <Cbb/NoteValue.hpp>
 
+#include <algorithm>
+#include <functional>
+#include <utility>
+
 
 using namespace Cbb;
 
@@ -329,6 +333,176 @@ TEST_CASE("Prepending to a note vlaue places note values onto the start of a com
     }
 }
 
+TEST_CASE("A composite note value keeps its note values in order when it outgrows its inline "
+          "storage",
+          "[NoteValue]")
+{
+    const auto isIdentical = [](const NoteValue& left, const NoteValue& right) {
+        return left.base() == right.base() && left.tuplet() == right.tuplet()
+               && left.numDots() == right.numDots();
+    };
+
+    const auto expected = {NoteValue(thirtySecondNote),
+                           NoteValue(wholeNote),
+                           NoteValue(eighthNote, triplet),
+                           NoteValue(sixteenthNote, 1),
+                           NoteValue(halfNote)};
+
+    SECTION("Appending")
+    {
+        auto a = CompositeNoteValue({thirtySecondNote, wholeNote});
+        a.append(CompositeNoteValue({{eighthNote, triplet}, {sixteenthNote, 1}}));
+        a.append(halfNote);
+
+        REQUIRE(a.size() == 5);
+        REQUIRE(std::equal(a.begin(), a.end(), expected.begin(), expected.end(), isIdentical));
+    }
+
+    SECTION("Prepending")
+    {
+        auto a = CompositeNoteValue({{sixteenthNote, 1}, halfNote});
+        a.prepend(CompositeNoteValue({eighthNote, triplet}));
+        a.prepend(CompositeNoteValue({thirtySecondNote, wholeNote}));
+
+        REQUIRE(a.size() == 5);
+        REQUIRE(std::equal(a.begin(), a.end(), expected.begin(), expected.end(), isIdentical));
+    }
+
+    SECTION("Constructing and copying")
+    {
+        const auto a = CompositeNoteValue(expected);
+        const auto b = a;
+
+        REQUIRE(std::equal(b.begin(), b.end(), expected.begin(), expected.end(), isIdentical));
+    }
+
+    SECTION("Appending a composite note value to itself")
+    {
+        auto a = CompositeNoteValue({quarterNote, eighthNote});
+        a.append(a);
+        a.prepend(a);
+
+        REQUIRE(a.size() == 8);
+        REQUIRE(relativeValue(a) == Fraction(3, 2));
+        REQUIRE(isIdentical(a[6], quarterNote));
+        REQUIRE(isIdentical(a[7], eighthNote));
+    }
+
+    SECTION("Moving")
+    {
+        auto a = CompositeNoteValue(expected);
+        auto b = std::move(a);
+
+        REQUIRE(std::equal(b.begin(), b.end(), expected.begin(), expected.end(), isIdentical));
+
+        auto c = CompositeNoteValue({quarterNote, eighthNote});
+        c = std::move(b);
+
+        REQUIRE(std::equal(c.begin(), c.end(), expected.begin(), expected.end(), isIdentical));
+
+        for (const auto* movedFrom : {&a, &b})
+        {
+            REQUIRE(movedFrom->size() == 1);
+            REQUIRE(isIdentical((*movedFrom)[0], wholeNote));
+            REQUIRE(relativeValue(*movedFrom) == Fraction(1));
+        }
+
+        a.append(CompositeNoteValue({halfNote, quarterNote, eighthNote}));
+
+        REQUIRE(a.size() == 4);
+        REQUIRE(relativeValue(a) == Fraction(15, 8));
+        REQUIRE(isIdentical(a[3], eighthNote));
+    }
+}
+
+TEST_CASE("Replacing a note value of a composite note value through the subscript operator "
+          "updates its relative value",
+          "[NoteValue]")
+{
+    auto a = CompositeNoteValue({quarterNote, eighthNote, {sixteenthNote, triplet}, halfNote});
+
+    SECTION("Assigning a note value")
+    {
+        a[1] = NoteValue(eighthNote, 1);
+
+        REQUIRE(a[1].numDots() == 1);
+        REQUIRE(relativeValue(a) == Fraction(3, 4) + Fraction(3, 16) + Fraction(1, 24));
+    }
+
+    SECTION("Assigning another note value of the same composite note value")
+    {
+        a[0] = a[3];
+
+        REQUIRE(a[0].base() == halfNote);
+        REQUIRE(relativeValue(a) == Fraction(1) + Fraction(1, 8) + Fraction(1, 24));
+    }
+
+    SECTION("Writing through iterators")
+    {
+        std::fill(a.begin(), a.end(), NoteValue(eighthNote));
+        *a.rbegin() = quarterNote;
+
+        REQUIRE(relativeValue(a) == Fraction(5, 8));
+    }
+
+    SECTION("Sorting")
+    {
+        std::sort(a.begin(), a.end());
+
+        REQUIRE(a == CompositeNoteValue({{sixteenthNote, triplet}, eighthNote, quarterNote,
+                                         halfNote}));
+        REQUIRE(relativeValue(a) == Fraction(7, 8) + Fraction(1, 24));
+
+        std::sort(a.begin(), a.end(), std::greater<>());
+
+        REQUIRE(a[0].base() == halfNote);
+        REQUIRE(a[3].tuplet() == triplet);
+    }
+
+    SECTION("Reversing")
+    {
+        std::reverse(a.begin(), a.end());
+
+        REQUIRE(a == CompositeNoteValue({halfNote, {sixteenthNote, triplet}, eighthNote,
+                                         quarterNote}));
+        REQUIRE(relativeValue(a) == Fraction(7, 8) + Fraction(1, 24));
+    }
+
+    SECTION("Swapping")
+    {
+        using std::swap;
+        swap(a[0], a[3]);
+
+        REQUIRE(a[0].base() == halfNote);
+        REQUIRE(a[3].base() == quarterNote);
+        REQUIRE(relativeValue(a) == Fraction(7, 8) + Fraction(1, 24));
+    }
+
+    SECTION("Reading through a range-based for loop")
+    {
+        auto total = Fraction(0);
+
+        for (const NoteValue& value : a)
+            total = boundedSum(total, value.relativeValue());
+
+        for (auto&& value : a)
+            value = eighthNote;
+
+        REQUIRE(total == Fraction(7, 8) + Fraction(1, 24));
+        REQUIRE(relativeValue(a) == Fraction(1, 2));
+    }
+
+    SECTION("Appending after replacing")
+    {
+        a[2] = sixteenthNote;
+        a += quarterNote;
+
+        REQUIRE(a == CompositeNoteValue({quarterNote, eighthNote, sixteenthNote, halfNote,
+                                         quarterNote}));
+        REQUIRE(relativeValue(a) == Fraction(19, 16));
+    }
+}
+
 TEST_CASE("Adding one note value(s) to another produces a composite note value that is the left "
           "note value(s) tied with the right note value(s)",
           "[NoteValue]")
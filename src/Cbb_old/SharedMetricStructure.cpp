@@ -0,0 +1,162 @@
+#include <Cbb/SharedMetricStructure.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+
+
+namespace Cbb {
+
+
+SharedMetricStructure::SharedMetricStructure(MetricStructure metricStructure) :
+    current_ {new MetricStructure(std::move(metricStructure))}
+{
+}
+
+SharedMetricStructure::~SharedMetricStructure()
+{
+    delete current_.load();
+}
+
+SharedMetricStructure::Reader SharedMetricStructure::reader()
+{
+    for (std::size_t index = 0; index < maxNumReaders; ++index)
+    {
+        auto isRegistered = false;
+
+        if (isReaderRegistered_[index].compare_exchange_strong(isRegistered, true))
+            return Reader(*this, index);
+    }
+
+    throw std::length_error("too many readers of a shared metric structure");
+}
+
+void SharedMetricStructure::publish(MetricStructure metricStructure)
+{
+    const auto lock = std::lock_guard<std::mutex>(updateMutex_);
+
+    publishLocked(std::move(metricStructure));
+}
+
+void SharedMetricStructure::publishLocked(MetricStructure metricStructure)
+{
+    auto published = std::make_unique<const MetricStructure>(std::move(metricStructure));
+
+    // A reader that announces an epoch before this increment may have loaded the replaced
+    // snapshot; one that announces it after loads the published one or a later one
+    auto replaced = std::unique_ptr<const MetricStructure>(current_.exchange(published.release()));
+    const auto epoch = epoch_.fetch_add(1) + 1;
+
+    retired_.push_back({std::move(replaced), epoch});
+    reclaimLocked();
+}
+
+std::size_t SharedMetricStructure::reclaim()
+{
+    const auto lock = std::lock_guard<std::mutex>(updateMutex_);
+
+    return reclaimLocked();
+}
+
+std::size_t SharedMetricStructure::reclaimLocked()
+{
+    auto oldestReaderEpoch = std::numeric_limits<std::uint64_t>::max();
+
+    for (const auto& readerEpoch : readerEpochs_)
+    {
+        const auto epoch = readerEpoch.load();
+
+        if (epoch != 0)
+            oldestReaderEpoch = std::min(oldestReaderEpoch, epoch);
+    }
+
+    // A snapshot retired at an epoch can only be read by readers that announced an earlier one
+    retired_.erase(std::remove_if(retired_.begin(),
+                                  retired_.end(),
+                                  [oldestReaderEpoch](const RetiredSnapshot& retired) {
+                                      return retired.epoch <= oldestReaderEpoch;
+                                  }),
+                   retired_.end());
+
+    return retired_.size();
+}
+
+SharedMetricStructure::Reader::Reader(SharedMetricStructure& shared,
+                                      const std::size_t index) noexcept :
+    shared_ {&shared},
+    index_ {index}
+{
+}
+
+SharedMetricStructure::Reader::Reader(Reader&& other) noexcept :
+    shared_ {std::exchange(other.shared_, nullptr)},
+    index_ {other.index_}
+{
+}
+
+SharedMetricStructure::Reader& SharedMetricStructure::Reader::operator=(Reader&& other) noexcept
+{
+    if (this != &other)
+    {
+        if (shared_ != nullptr)
+            shared_->isReaderRegistered_[index_].store(false);
+
+        shared_ = std::exchange(other.shared_, nullptr);
+        index_ = other.index_;
+    }
+
+    return *this;
+}
+
+SharedMetricStructure::Reader::~Reader()
+{
+    if (shared_ != nullptr)
+        shared_->isReaderRegistered_[index_].store(false);
+}
+
+SharedMetricStructure::Snapshot SharedMetricStructure::Reader::read() noexcept
+{
+    auto& readerEpoch = shared_->readerEpochs_[index_];
+    readerEpoch.store(shared_->epoch_.load());
+
+    return Snapshot(readerEpoch, *shared_->current_.load());
+}
+
+SharedMetricStructure::Snapshot::Snapshot(std::atomic<std::uint64_t>& readerEpoch,
+                                          const MetricStructure& metricStructure) noexcept :
+    readerEpoch_ {&readerEpoch},
+    metricStructure_ {&metricStructure}
+{
+}
+
+SharedMetricStructure::Snapshot::Snapshot(Snapshot&& other) noexcept :
+    readerEpoch_ {std::exchange(other.readerEpoch_, nullptr)},
+    metricStructure_ {other.metricStructure_}
+{
+}
+
+SharedMetricStructure::Snapshot&
+SharedMetricStructure::Snapshot::operator=(Snapshot&& other) noexcept
+{
+    if (this != &other)
+    {
+        // Snapshots of the same reader share its epoch, which the other snapshot announced when it
+        // was read, so clearing it would leave the other snapshot unprotected
+        if (readerEpoch_ != nullptr && readerEpoch_ != other.readerEpoch_)
+            readerEpoch_->store(0);
+
+        readerEpoch_ = std::exchange(other.readerEpoch_, nullptr);
+        metricStructure_ = other.metricStructure_;
+    }
+
+    return *this;
+}
+
+SharedMetricStructure::Snapshot::~Snapshot()
+{
+    if (readerEpoch_ != nullptr)
+        readerEpoch_->store(0);
+}
+
+
+}; // namespace Cbb
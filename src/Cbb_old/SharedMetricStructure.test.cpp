@@ -0,0 +1,230 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include <Cbb/SharedMetricStructure.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <sstream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+
+using namespace Cbb;
+
+
+namespace {
+
+
+TempoBpm bpmAt(const BarNumber bar)
+{
+    return 60 + bar % 80;
+}
+
+
+}; // namespace
+
+
+SCENARIO("A shared metric structure publishes snapshots")
+{
+    GIVEN("A shared metric structure and a reader")
+    {
+        auto shared = SharedMetricStructure(MetricStructure({4, 4}, 120));
+        auto reader = shared.reader();
+
+        WHEN("An update is published")
+        {
+            shared.update([](MetricStructure& metricStructure) {
+                metricStructure.addBpmChange({3, 0}, 90);
+            });
+
+            THEN("A read sees it")
+            {
+                const auto snapshot = reader.read();
+
+                REQUIRE(snapshot->bpmChanges().size() == 2);
+                REQUIRE(snapshot->lastestBpmChange({5, 0}).second == 90);
+            }
+        }
+
+        WHEN("A snapshot is held while an update is published")
+        {
+            {
+                const auto snapshot = reader.read();
+
+                shared.publish(MetricStructure({3, 4}, 100));
+
+                THEN("The snapshot is unchanged and is not reclaimed")
+                {
+                    REQUIRE(snapshot->lastestBpmChange({5, 0}).second == 120);
+                    REQUIRE(snapshot->lastestTimeSignatureChange({5, 0}).second
+                            == TimeSignature(4, 4));
+                    REQUIRE(shared.reclaim() == 1);
+                }
+            }
+
+            THEN("It is reclaimed once the snapshot is destroyed")
+            {
+                REQUIRE(shared.reclaim() == 0);
+                REQUIRE(reader.read()->lastestBpmChange({5, 0}).second == 100);
+            }
+        }
+
+        WHEN("A held snapshot is assigned a new read, as an audio callback would")
+        {
+            auto snapshot = reader.read();
+
+            shared.publish(MetricStructure({3, 4}, 100));
+            snapshot = reader.read();
+            shared.publish(MetricStructure({5, 4}, 80));
+
+            THEN("The new snapshot stays protected")
+            {
+                REQUIRE(shared.reclaim() == 1);
+                REQUIRE(snapshot->lastestBpmChange({5, 0}).second == 100);
+                REQUIRE(snapshot->lastestTimeSignatureChange({5, 0}).second
+                        == TimeSignature(3, 4));
+            }
+        }
+
+        WHEN("A snapshot is taken after an update")
+        {
+            shared.publish(MetricStructure({3, 4}, 100));
+            const auto snapshot = reader.read();
+
+            THEN("It does not keep the replaced snapshot from being reclaimed")
+            {
+                REQUIRE(shared.reclaim() == 0);
+            }
+        }
+    }
+}
+
+TEST_CASE("A shared metric structure has a limited number of readers")
+{
+    auto shared = SharedMetricStructure(MetricStructure({4, 4}, 120));
+    auto readers = std::vector<SharedMetricStructure::Reader>();
+
+    for (std::size_t i = 0; i < SharedMetricStructure::maxNumReaders; ++i)
+        readers.push_back(shared.reader());
+
+    REQUIRE_THROWS_AS(shared.reader(), std::length_error);
+
+    readers.pop_back();
+
+    REQUIRE_NOTHROW(shared.reader());
+}
+
+TEST_CASE("Readers of a shared metric structure see consistent snapshots while it is updated")
+{
+    constexpr auto numUpdates = 2000;
+    constexpr auto numReaders = 3;
+
+    auto shared = SharedMetricStructure(MetricStructure({4, 4}, bpmAt(0)));
+    auto isUpdating = std::atomic<bool>(true);
+    auto numInconsistentReads = std::atomic<int>(0);
+    auto latencies = std::vector<std::vector<std::chrono::nanoseconds>>(numReaders);
+    auto readerThreads = std::vector<std::thread>();
+
+    for (auto& readerLatencies : latencies)
+    {
+        readerLatencies.reserve(1 << 20);
+
+        readerThreads.emplace_back([&shared, &isUpdating, &numInconsistentReads, &readerLatencies] {
+            auto reader = shared.reader();
+            auto query = BarNumber(0);
+
+            while (isUpdating.load())
+            {
+                const auto start = std::chrono::steady_clock::now();
+                const auto snapshot = reader.read();
+
+                // The writer adds a change at every bar, in order
+                const auto numBars = BarNumber(snapshot->bpmChanges().size());
+                const auto change = snapshot->lastestBpmChange({query % numBars, 0});
+                const auto lastChange = snapshot->bpmChanges().back();
+                const auto end = std::chrono::steady_clock::now();
+
+                if (change.second != bpmAt(query % numBars) || lastChange.first.bar != numBars - 1)
+                    ++numInconsistentReads;
+
+                if (readerLatencies.size() < readerLatencies.capacity())
+                    readerLatencies.push_back(end - start);
+
+                ++query;
+            }
+        });
+    }
+
+    for (auto bar = BarNumber(1); bar <= numUpdates; ++bar)
+    {
+        shared.update([bar](MetricStructure& metricStructure) {
+            metricStructure.addBpmChange({bar, 0}, bpmAt(bar));
+        });
+    }
+
+    isUpdating.store(false);
+
+    for (auto& thread : readerThreads)
+        thread.join();
+
+    REQUIRE(numInconsistentReads.load() == 0);
+    REQUIRE(shared.reclaim() == 0);
+
+    auto allLatencies = std::vector<std::chrono::nanoseconds>();
+
+    for (const auto& readerLatencies : latencies)
+        allLatencies.insert(allLatencies.end(), readerLatencies.begin(), readerLatencies.end());
+
+    REQUIRE(!allLatencies.empty());
+
+    std::sort(allLatencies.begin(), allLatencies.end());
+
+    const auto percentile = [&allLatencies](const double p) {
+        return allLatencies[std::size_t(p * double(allLatencies.size() - 1))].count();
+    };
+
+    auto report = std::ostringstream();
+    report << allLatencies.size() << " reads, latency in ns: p50 " << percentile(0.5) << ", p99 "
+           << percentile(0.99) << ", p99.9 " << percentile(0.999) << ", max "
+           << allLatencies.back().count();
+
+    WARN(report.str());
+}
+
+TEST_CASE("Concurrent updates of a shared metric structure are not lost")
+{
+    constexpr auto numUpdatesPerWriter = 1000;
+
+    auto shared = SharedMetricStructure(MetricStructure({4, 4}, bpmAt(0)));
+    auto writerThreads = std::vector<std::thread>();
+
+    // Each writer adds a change at every other bar
+    for (auto writer = 0; writer < 2; ++writer)
+    {
+        writerThreads.emplace_back([&shared, writer] {
+            for (auto i = 0; i < numUpdatesPerWriter; ++i)
+            {
+                const auto bar = BarNumber(1 + 2 * i + writer);
+
+                shared.update([bar](MetricStructure& metricStructure) {
+                    metricStructure.addBpmChange({bar, 0}, bpmAt(bar));
+                });
+            }
+        });
+    }
+
+    for (auto& thread : writerThreads)
+        thread.join();
+
+    auto reader = shared.reader();
+    const auto snapshot = reader.read();
+    const auto bpmChanges = snapshot->bpmChanges();
+
+    REQUIRE(bpmChanges.size() == 2 * numUpdatesPerWriter + 1);
+
+    for (const auto& [position, bpm] : bpmChanges)
+        REQUIRE(bpm == bpmAt(position.bar));
+}
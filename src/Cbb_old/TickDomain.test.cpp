@@ -0,0 +1,115 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include <Cbb/TickDomain.hpp>
+
+#include <array>
+#include <unordered_set>
+#include <vector>
+
+
+using namespace Cbb;
+
+
+TEST_CASE("A default-constructed tick domain has one tick per whole", "[TickDomain]")
+{
+    REQUIRE(TickDomain().resolution() == 1);
+}
+
+TEST_CASE("A tick domain must have a positive resolution", "[TickDomain]")
+{
+    REQUIRE(TickDomain(960).resolution() == 960);
+    REQUIRE_THROWS_AS(TickDomain(0), std::invalid_argument);
+    REQUIRE_THROWS_AS(TickDomain(-4), std::invalid_argument);
+}
+
+TEST_CASE("Fractions can be projected to ticks", "[TickDomain]")
+{
+    constexpr auto domain = TickDomain(48);
+
+    STATIC_REQUIRE(domain.toTicks({3, 4}) == 36);
+    STATIC_REQUIRE(domain.toTicks({1, -6}) == -8);
+    STATIC_REQUIRE(domain.toTicks({-10, -20}) == 24);
+    STATIC_REQUIRE(domain.toTicks(5) == 240);
+
+    REQUIRE_THROWS_AS(domain.toTicks({1, 5}), std::invalid_argument);
+    REQUIRE_THROWS_AS(domain.toTicks({1, 0}), std::invalid_argument);
+    REQUIRE_THROWS_AS(TickDomain(1LL << 62).toTicks(4), std::overflow_error);
+}
+
+TEST_CASE("Ticks can be projected back to reduced fractions", "[TickDomain]")
+{
+    constexpr auto domain = TickDomain(48);
+
+    REQUIRE(symbolicallyEqual(domain.toFraction(36), {3, 4}));
+    REQUIRE(symbolicallyEqual(domain.toFraction(-8), {-1, 6}));
+    REQUIRE(symbolicallyEqual(domain.toFraction(0), {0, 1}));
+}
+
+TEST_CASE("Ranges of fractions and ticks can be projected", "[TickDomain]")
+{
+    const auto domain = TickDomain(48);
+    const auto fractions = std::vector<Fraction> {{1, 4}, {1, 3}, {7, 8}};
+
+    auto ticks = std::vector<long long>(fractions.size());
+    auto roundTrip = std::vector<Fraction>(fractions.size());
+
+    domain.toTicks(fractions.begin(), fractions.end(), ticks.begin());
+    domain.toFractions(ticks.begin(), ticks.end(), roundTrip.begin());
+
+    REQUIRE(ticks == std::vector<long long> {12, 16, 42});
+    REQUIRE(roundTrip == fractions);
+}
+
+TEST_CASE("Tick domains have a least common domain", "[TickDomain]")
+{
+    STATIC_REQUIRE(commonTickDomain(TickDomain(6), TickDomain(4)) == TickDomain(12));
+    REQUIRE_THROWS_AS(commonTickDomain(TickDomain(1LL << 62), TickDomain(3)),
+                      std::overflow_error);
+}
+
+TEST_CASE("A set of fractions has a least common tick domain", "[TickDomain]")
+{
+    constexpr auto fractions = std::array<Fraction, 4> {{{1, 4}, {2, 6}, {5, -8}, {3, 1}}};
+
+    STATIC_REQUIRE(commonTickDomain(fractions.begin(), fractions.end()) == TickDomain(24));
+
+    const auto undefined = std::vector<Fraction> {{1, 0}};
+
+    REQUIRE_THROWS_AS(commonTickDomain(undefined.begin(), undefined.end()),
+                      std::invalid_argument);
+}
+
+TEST_CASE("A set of note values has a least common tick domain", "[TickDomain]")
+{
+    // 1/4, 1/12, 3/32 and 1/5
+    constexpr auto noteValues = std::array {NoteValue(quarterNote),
+                                            NoteValue(eighthNote, triplet),
+                                            NoteValue(sixteenthNote, 1),
+                                            NoteValue(halfNote, quintuplet)};
+
+    STATIC_REQUIRE(noteValueTickDomain(noteValues.begin(), noteValues.end()) == TickDomain(480));
+
+    for (const auto& noteValue : noteValues)
+        REQUIRE(TickDomain(480).toTicks(relativeValue(noteValue)) > 0);
+}
+
+TEST_CASE("Ticks order and hash like their fractions", "[TickDomain]")
+{
+    const auto fractions = std::vector<Fraction> {{5, 8}, {1, 3}, {-1, 2}, {2, 6}, {7, 8}};
+    const auto domain = commonTickDomain(fractions.begin(), fractions.end());
+
+    for (const auto& left : fractions)
+        for (const auto& right : fractions)
+        {
+            REQUIRE((left < right) == (domain.toTicks(left) < domain.toTicks(right)));
+            REQUIRE((left == right) == (domain.toTicks(left) == domain.toTicks(right)));
+        }
+
+    auto distinct = std::unordered_set<long long>();
+
+    for (const auto& fraction : fractions)
+        distinct.insert(domain.toTicks(fraction));
+
+    REQUIRE(distinct.size() == 4);
+}
@@ -0,0 +1 @@
+#include <cbb/dyadic.hpp>
@@ -0,0 +1,176 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include <cbb/dyadic.hpp>
+#include <cbb/note_value_constants.hpp>
+
+#include <climits>
+
+
+using namespace cbb;
+using namespace ieme::fraction_literals;
+
+
+TEST_CASE("dyadic construction", "[dyadic]")
+{
+  SECTION("default")
+  {
+    STATIC_REQUIRE(dyadic().get_mantissa() == 0);
+    STATIC_REQUIRE(dyadic().get_power_of_2() == numbers::_1);
+  }
+
+  SECTION("from mantissa and power of 2")
+  {
+    constexpr auto d = dyadic(12, numbers::one_8th);
+
+    STATIC_REQUIRE(d.get_mantissa() == 3);
+    STATIC_REQUIRE(d.get_power_of_2() == numbers::one_half);
+
+    STATIC_REQUIRE(dyadic(-20).get_mantissa() == -5);
+    STATIC_REQUIRE(dyadic(-20).get_power_of_2() == numbers::_4);
+    STATIC_REQUIRE(dyadic(INT_MIN).get_mantissa() == -1);
+    STATIC_REQUIRE(dyadic(0, numbers::_4) == dyadic());
+  }
+
+  SECTION("from power of 2")
+  {
+    STATIC_REQUIRE(dyadic(numbers::one_16th).get_mantissa() == 1);
+    STATIC_REQUIRE(dyadic(numbers::one_16th).get_power_of_2()
+                   == numbers::one_16th);
+  }
+
+  SECTION("from fraction")
+  {
+    constexpr auto d = dyadic(fraction(6, -16));
+
+    STATIC_REQUIRE(d.get_mantissa() == -3);
+    STATIC_REQUIRE(d.get_power_of_2() == numbers::one_8th);
+
+    STATIC_REQUIRE(dyadic(fraction(0, 3)) == dyadic());
+    REQUIRE_THROWS_AS(dyadic(fraction(1, 3)), std::invalid_argument);
+  }
+}
+
+TEST_CASE("dyadic conversion to fraction", "[dyadic]")
+{
+  STATIC_REQUIRE(dyadic(3, numbers::one_8th).get_value() == 3 / 8_fr);
+  STATIC_REQUIRE(dyadic(-5, numbers::_4).get_value() == -20);
+  STATIC_REQUIRE(dyadic().get_value() == 0);
+  STATIC_REQUIRE(dyadic(fraction(-7, 64)).get_value() == -7 / 64_fr);
+
+  REQUIRE_THROWS_AS(dyadic(3, power_of_2(power_of_2::from_exponent, 30))
+                      .get_value(),
+                    std::overflow_error);
+  REQUIRE_THROWS_AS(dyadic(1, power_of_2(power_of_2::from_exponent, -31))
+                      .get_value(),
+                    std::overflow_error);
+}
+
+TEST_CASE("dyadic comparison", "[dyadic]")
+{
+  constexpr auto huge = power_of_2(power_of_2::from_exponent, 200);
+  constexpr auto tiny = power_of_2(power_of_2::from_exponent, -200);
+
+  STATIC_REQUIRE(dyadic(3, numbers::one_8th) < dyadic(numbers::one_half));
+  STATIC_REQUIRE(dyadic(5, numbers::one_8th) > dyadic(numbers::one_half));
+  STATIC_REQUIRE(dyadic(4, numbers::one_8th) == dyadic(numbers::one_half));
+  STATIC_REQUIRE(dyadic(-3, numbers::one_8th) > dyadic(-1));
+  STATIC_REQUIRE(dyadic(-1) < dyadic());
+  STATIC_REQUIRE(dyadic(1, tiny) > dyadic());
+  STATIC_REQUIRE(dyadic(1, huge) > dyadic(INT_MAX));
+  STATIC_REQUIRE(dyadic(-1, huge) < dyadic(-INT_MAX, tiny));
+  STATIC_REQUIRE(dyadic(INT_MAX, tiny)
+                 < dyadic(1, tiny * power_of_2(power_of_2::from_exponent, 31)));
+  STATIC_REQUIRE(compare(dyadic(7, numbers::_2), dyadic(14)) == 0);
+}
+
+TEST_CASE("dyadic arithmetic", "[dyadic]")
+{
+  SECTION("sum")
+  {
+    STATIC_REQUIRE(dyadic(3, numbers::one_8th) + dyadic(numbers::one_8th)
+                   == dyadic(numbers::one_half));
+    STATIC_REQUIRE(dyadic(3, numbers::one_8th) - dyadic(numbers::one_half)
+                   == dyadic(-1, numbers::one_8th));
+    STATIC_REQUIRE(dyadic(5) + dyadic(-5) == dyadic());
+    STATIC_REQUIRE(dyadic(1, numbers::_256) + dyadic(1, numbers::one_256th)
+                   == dyadic(65537, numbers::one_256th));
+
+    REQUIRE_THROWS_AS(dyadic(1, power_of_2(power_of_2::from_exponent, 40))
+                        + dyadic(1),
+                      std::overflow_error);
+  }
+
+  SECTION("product")
+  {
+    STATIC_REQUIRE(dyadic(3, numbers::one_4th) * dyadic(-5, numbers::_2)
+                   == dyadic(-15, numbers::one_half));
+    STATIC_REQUIRE(dyadic(3) * numbers::one_16th
+                   == dyadic(3, numbers::one_16th));
+    STATIC_REQUIRE(numbers::_4 * dyadic(3) == dyadic(12));
+    STATIC_REQUIRE(dyadic(3) / numbers::_4 == dyadic(3, numbers::one_4th));
+    STATIC_REQUIRE(dyadic() * numbers::_4 == dyadic());
+
+    REQUIRE_THROWS_AS(dyadic(65535) * dyadic(65537), std::overflow_error);
+  }
+
+  SECTION("compound assignment")
+  {
+    auto d = dyadic(3, numbers::one_8th);
+
+    d += dyadic(numbers::one_8th);
+    REQUIRE(d == dyadic(numbers::one_half));
+
+    d *= numbers::one_4th;
+    REQUIRE(d == dyadic(numbers::one_8th));
+
+    d /= numbers::one_half;
+    REQUIRE(d == dyadic(numbers::one_4th));
+  }
+}
+
+TEST_CASE("dyadic note values", "[dyadic]")
+{
+  SECTION("relative value")
+  {
+    STATIC_REQUIRE(dyadic_relative_value(_8th_note)
+                   == dyadic(numbers::one_8th));
+    STATIC_REQUIRE(dyadic_relative_value(quarter_note.with(dot_count::single))
+                   == dyadic(3, numbers::one_8th));
+    STATIC_REQUIRE(
+      dyadic_relative_value(note_value(numbers::one_half, dot_count::triple))
+      == dyadic(15, numbers::one_16th));
+    STATIC_REQUIRE(dyadic_relative_value(
+                     note_value(numbers::one_4th, tuplet::quadruplet))
+                   == dyadic(numbers::one_8th));
+
+    REQUIRE_THROWS_AS(dyadic_relative_value(_8th_note.with(tuplet::triplet)),
+                      std::invalid_argument);
+  }
+
+  SECTION("agrees with relative_value")
+  {
+    for (auto const dots : {dot_count::none,
+                            dot_count::single,
+                            dot_count::_double,
+                            dot_count::triple})
+      for (auto exponent = -8; exponent <= 2; ++exponent)
+      {
+        auto const nv
+          = note_value(power_of_2(power_of_2::from_exponent, exponent), dots);
+
+        REQUIRE(dyadic_relative_value(nv).get_value() == relative_value(nv));
+      }
+  }
+
+  SECTION("to note value")
+  {
+    STATIC_REQUIRE(to_note_value(dyadic(3, numbers::one_8th))
+                   == quarter_note.with(dot_count::single));
+    STATIC_REQUIRE(to_note_value(dyadic(numbers::one_half)) == half_note);
+
+    REQUIRE_THROWS_AS(to_note_value(dyadic(5)), std::invalid_argument);
+    REQUIRE_THROWS_AS(to_note_value(dyadic(-1)), std::invalid_argument);
+    REQUIRE_THROWS_AS(to_note_value(dyadic(31)), std::invalid_argument);
+  }
+}
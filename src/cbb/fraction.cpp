@@ -0,0 +1 @@
+#include <cbb/fraction.hpp>
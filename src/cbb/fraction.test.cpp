@@ -0,0 +1,134 @@
+#include <cbb/fraction.hpp>
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include <climits>
+#include <iterator>
+#include <string_view>
+
+
+using namespace cbb;
+
+
+TEST_CASE("fraction comparison", "[fraction]")
+{
+  SECTION("same denominator")
+  {
+    STATIC_REQUIRE(compare(fraction(3, 7), fraction(5, 7)) < 0);
+    STATIC_REQUIRE(compare(fraction(5, 7), fraction(5, 7)) == 0);
+    STATIC_REQUIRE(compare(fraction(-3, 7), fraction(-5, 7)) > 0);
+  }
+
+  SECTION("power of 2 denominators")
+  {
+    STATIC_REQUIRE(compare(fraction(3, 8), fraction(1, 2)) < 0);
+    STATIC_REQUIRE(compare(fraction(1, 2), fraction(3, 8)) > 0);
+    STATIC_REQUIRE(compare(fraction(4, 8), fraction(1, 2)) == 0);
+    STATIC_REQUIRE(compare(fraction(INT_MAX, 1), fraction(1, 1 << 30)) > 0);
+    STATIC_REQUIRE(compare(fraction(-INT_MAX, 1), fraction(1, 1 << 30)) < 0);
+  }
+
+  SECTION("negative denominators")
+  {
+    STATIC_REQUIRE(compare(fraction(1, -3), fraction(-1, 3)) == 0);
+    STATIC_REQUIRE(compare(fraction(1, -3), fraction(1, 5)) < 0);
+  }
+
+  SECTION("large denominators")
+  {
+    STATIC_REQUIRE(compare(fraction(INT_MAX - 1, INT_MAX), fraction(1, 1)) < 0);
+    STATIC_REQUIRE(compare(fraction(INT_MAX - 2, INT_MAX - 1),
+                           fraction(INT_MAX - 1, INT_MAX))
+                   < 0);
+  }
+
+  SECTION("continued fraction fallback")
+  {
+    STATIC_REQUIRE(detail::compare_by_continued_fraction(2, 3, 3, 5) > 0);
+    STATIC_REQUIRE(detail::compare_by_continued_fraction(3, 5, 2, 3) < 0);
+    STATIC_REQUIRE(detail::compare_by_continued_fraction(6, 9, 2, 3) == 0);
+    STATIC_REQUIRE(detail::compare_by_continued_fraction(-2, 3, -3, 5) < 0);
+    STATIC_REQUIRE(detail::compare_by_continued_fraction(0, 3, -3, 5) > 0);
+    STATIC_REQUIRE(detail::compare_by_continued_fraction(7, 1, 43, 6) < 0);
+    STATIC_REQUIRE(
+      detail::compare_by_continued_fraction(LLONG_MAX - 1, LLONG_MAX, 1LL, 1LL)
+      < 0);
+  }
+
+  SECTION("fraction_less")
+  {
+    STATIC_REQUIRE(fraction_less {}(fraction(1, 3), fraction(1, 2)));
+    STATIC_REQUIRE_FALSE(fraction_less {}(fraction(1, 2), fraction(2, 4)));
+  }
+}
+
+TEST_CASE("fraction binary gcd", "[fraction]")
+{
+  STATIC_REQUIRE(binary_gcd(0, 0) == 0);
+  STATIC_REQUIRE(binary_gcd(0, 12) == 12);
+  STATIC_REQUIRE(binary_gcd(-12, 0) == 12);
+  STATIC_REQUIRE(binary_gcd(48, 80) == 16);
+  STATIC_REQUIRE(binary_gcd(-96, 160) == 32);
+  STATIC_REQUIRE(binary_gcd(7 * 64, 5 * 256) == 64);
+  STATIC_REQUIRE(binary_gcd(17, 13) == 1);
+  STATIC_REQUIRE(binary_gcd(1LL << 62, 3LL << 40) == 1LL << 40);
+}
+
+TEST_CASE("fraction binary reduce", "[fraction]")
+{
+  constexpr auto reduced = binary_reduce(fraction(12, -32));
+
+  STATIC_REQUIRE(reduced.numerator() == -3);
+  STATIC_REQUIRE(reduced.denominator() == 8);
+
+  STATIC_REQUIRE(binary_reduce(fraction(0, 5)).denominator() == 1);
+  STATIC_REQUIRE(binary_reduce(fraction(7, 9)).numerator() == 7);
+}
+
+TEST_CASE("fraction from chars", "[fraction]")
+{
+  auto f = fraction(0, 1);
+
+  SECTION("numerator and denominator")
+  {
+    auto const text = std::string_view("-5/7 3/4");
+    auto const result = from_chars(text, f);
+
+    REQUIRE(result.ec == std::errc());
+    REQUIRE(result.ptr == text.data() + 4);
+    REQUIRE(f.numerator() == -5);
+    REQUIRE(f.denominator() == 7);
+  }
+
+  SECTION("integer")
+  {
+    REQUIRE(from_chars("12", f).ec == std::errc());
+    REQUIRE(f.numerator() == 12);
+    REQUIRE(f.denominator() == 1);
+  }
+
+  SECTION("errors")
+  {
+    REQUIRE(from_chars(" 3/4", f).ec == std::errc::invalid_argument);
+    REQUIRE(from_chars("3/", f).ec == std::errc::invalid_argument);
+    REQUIRE(from_chars("3/0", f).ec == std::errc::invalid_argument);
+    REQUIRE(from_chars("1/4294967296", f).ec == std::errc::result_out_of_range);
+    REQUIRE(f.numerator() == 0);
+  }
+}
+
+TEST_CASE("fraction to chars", "[fraction]")
+{
+  char buffer[16];
+
+  auto const result
+    = to_chars(std::begin(buffer), std::end(buffer), fraction(-5, 7));
+
+  REQUIRE(result.ec == std::errc());
+  REQUIRE(std::string_view(buffer, result.ptr - buffer) == "-5/7");
+
+  REQUIRE(to_chars(buffer, buffer + 2, fraction(-5, 7)).ec
+          == std::errc::value_too_large);
+  REQUIRE(to_chars(buffer, buffer + 3, fraction(-5, 7)).ec
+          == std::errc::value_too_large);
+}
@@ -0,0 +1,123 @@
+#define CATCH_CONFIG_MAIN
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include <catch2/catch.hpp>
+
+#include <cbb/note_value_constants.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+
+using namespace cbb;
+
+
+namespace {
+
+
+// A repeating mix of plain, dotted and tuplet note values as found in a part.
+// Every relative value fits in 16 bits.
+template <typename Rep>
+std::vector<basic_note_value<Rep>> make_note_values(std::size_t const size)
+{
+  auto const pattern = {_8th_note_v<Rep>.with(dot_count::single),
+                        _16th_note_v<Rep>,
+                        triplet_8th_note_v<Rep>,
+                        _16th_note_v<Rep>.with(tuplet::quintuplet),
+                        quarter_note_v<Rep>.with(dot_count::_double),
+                        _32nd_note_v<Rep>.with(tuplet::sextuplet),
+                        half_note_v<Rep>};
+
+  auto note_values = std::vector<basic_note_value<Rep>>();
+  note_values.reserve(size);
+
+  while (note_values.size() < size)
+    for (auto const& nv : pattern)
+      note_values.push_back(nv);
+
+  note_values.resize(size);
+
+  return note_values;
+}
+
+template <typename Rep>
+void benchmark_representation(char const* const name)
+{
+  auto const note_values = make_note_values<Rep>(1'000'000);
+
+  WARN(name << ": sizeof(basic_note_value) = "
+            << sizeof(basic_note_value<Rep>) << ", sizeof(basic_fraction) = "
+            << sizeof(basic_fraction<Rep>) << ", 10^6 note values = "
+            << note_values.size() * sizeof(basic_note_value<Rep>) << " bytes");
+
+  BENCHMARK(std::string(name) + " relative_value")
+  {
+    auto checksum = std::int64_t(0);
+
+    for (auto const& nv : note_values)
+    {
+      auto const value = relative_value(nv);
+      checksum += static_cast<std::int64_t>(value.numerator())
+                  ^ static_cast<std::int64_t>(value.denominator());
+    }
+
+    return checksum;
+  };
+
+  BENCHMARK(std::string(name) + " operator<")
+  {
+    auto count = std::size_t(0);
+
+    for (std::size_t i = 1; i < note_values.size(); ++i)
+      count += note_values[i - 1] < note_values[i];
+
+    return count;
+  };
+}
+
+
+} // namespace
+
+
+TEST_CASE("relative_value and comparison of 10^6 note values by "
+          "representation",
+          "[note_value][benchmark]")
+{
+  benchmark_representation<std::int16_t>("int16");
+  benchmark_representation<std::int32_t>("int32");
+  benchmark_representation<std::int64_t>("int64");
+#if defined(__SIZEOF_INT128__) && !defined(__STRICT_ANSI__)
+  benchmark_representation<__int128>("int128");
+#endif
+}
+
+TEST_CASE("Sorting 10^6 note values", "[note_value][benchmark]")
+{
+  auto const note_values = make_note_values<fraction_rep_t>(1'000'000);
+
+  auto const computed_less = [](note_value const& l, note_value const& r) {
+    return detail::computed_relative_value(l)
+           < detail::computed_relative_value(r);
+  };
+
+  auto sorted = note_values;
+  std::sort(sorted.begin(), sorted.end());
+
+  CHECK(std::is_sorted(sorted.begin(), sorted.end(), computed_less));
+
+  BENCHMARK("std::sort by computed relative values")
+  {
+    auto copy = note_values;
+    std::sort(copy.begin(), copy.end(), computed_less);
+    return copy;
+  };
+
+  BENCHMARK("std::sort by operator< (ranks)")
+  {
+    auto copy = note_values;
+    std::sort(copy.begin(), copy.end());
+    return copy;
+  };
+}
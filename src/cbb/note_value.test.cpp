@@ -3,6 +3,9 @@
 
 #include <cbb/note_value_constants.hpp>
 
+#include <cstdint>
+#include <vector>
+
 
 using namespace cbb;
 using namespace ieme::fraction_literals;
@@ -110,6 +113,66 @@ TEST_CASE("note_value comparison", "[note_value]")
   }
 }
 
+TEST_CASE("note_value relative value table", "[note_value]")
+{
+  using table = detail::relative_value_table;
+
+  auto note_values = std::vector<note_value>();
+
+  for (auto exponent = table::min_exponent; exponent <= table::max_exponent;
+       ++exponent)
+    for (auto count = 2; count <= 10; ++count)
+      for (auto dots = 0; dots <= 3; ++dots)
+        note_values.emplace_back(
+          power_of_2(power_of_2::from_exponent, exponent),
+          static_cast<tuplet>(count),
+          static_cast<dot_count>(dots));
+
+  REQUIRE(note_values.size() == table::size);
+
+  SECTION("the values are reduced and match fraction arithmetic")
+  {
+    for (auto const& nv : note_values)
+    {
+      auto const value = relative_value(nv);
+
+      REQUIRE(value == detail::computed_relative_value(nv));
+      REQUIRE(value
+              == nv.get_power_of_2().get_value()
+                   * tuplet_factor(nv.get_tuplet())
+                   * dot_augmentation(nv.get_num_dots()));
+      REQUIRE(binary_gcd(value.numerator(), value.denominator()) == 1);
+    }
+  }
+
+  SECTION("the ranks order the values")
+  {
+    for (auto const& l : note_values)
+      for (auto const& r : note_values)
+      {
+        auto const l_value = detail::computed_relative_value(l);
+        auto const r_value = detail::computed_relative_value(r);
+
+        if ((l == r) != (l_value == r_value) || (l < r) != (l_value < r_value))
+          FAIL("ranks disagree with relative values");
+      }
+  }
+
+  SECTION("outside the table")
+  {
+    constexpr auto tiny = note_value(
+      power_of_2(power_of_2::from_exponent, table::min_exponent - 1));
+    constexpr auto huge = note_value(
+      power_of_2(power_of_2::from_exponent, table::max_exponent + 1));
+
+    STATIC_REQUIRE(table::index_of(tiny) == table::size);
+    STATIC_REQUIRE(relative_value(tiny) == 1 / 8192_fr);
+    STATIC_REQUIRE(tiny < _256th_note.with(tuplet::decuplet));
+    STATIC_REQUIRE(huge == note_value(numbers::_32));
+    STATIC_REQUIRE(huge > octuple_whole_note.with(dot_count::triple));
+  }
+}
+
 TEST_CASE("note_value arithmetic operators", "[note_value]")
 {
   SECTION("operator*")
@@ -130,3 +193,31 @@ TEST_CASE("note_value arithmetic operators", "[note_value]")
                    == 1 / 4_fr);
   }
 }
+
+TEMPLATE_TEST_CASE("basic_note_value representations",
+                   "[note_value]",
+                   std::int16_t,
+                   std::int64_t)
+{
+  STATIC_REQUIRE(relative_value(triplet_8th_note_v<TestType>)
+                 == basic_fraction<TestType>(1, 12));
+  STATIC_REQUIRE(relative_value(half_note_v<TestType>.with(dot_count::single))
+                 == basic_fraction<TestType>(3, 4));
+  STATIC_REQUIRE(quarter_note_v<TestType> < half_note_v<TestType>);
+  STATIC_REQUIRE(quarter_note_v<TestType> * numbers::_2_v<TestType>
+                 == half_note_v<TestType>);
+}
+
+#if defined(__SIZEOF_INT128__) && !defined(__STRICT_ANSI__)
+TEST_CASE("basic_note_value with a 128-bit representation", "[note_value]")
+{
+  using nv = basic_note_value<__int128>;
+  using p2 = basic_power_of_2<__int128>;
+
+  constexpr auto tiny = nv(p2(p2::from_exponent, -100), tuplet::triplet);
+
+  STATIC_REQUIRE(relative_value(tiny)
+                 == basic_fraction<__int128>(1, __int128(3) << 99));
+  STATIC_REQUIRE(tiny < nv(p2(p2::from_exponent, -99)));
+}
+#endif
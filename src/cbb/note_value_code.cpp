@@ -0,0 +1 @@
+#include <cbb/note_value_code.hpp>
@@ -0,0 +1,155 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include <cbb/note_value_code.hpp>
+#include <cbb/note_value_constants.hpp>
+
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
+
+using namespace cbb;
+
+
+namespace {
+
+bool is_identical(note_value const& l, note_value const& r)
+{
+  return l.get_power_of_2() == r.get_power_of_2()
+         && l.get_tuplet() == r.get_tuplet()
+         && l.get_num_dots() == r.get_num_dots();
+}
+
+} // namespace
+
+
+TEST_CASE("note_value_code encoding", "[note_value_code]")
+{
+  SECTION("default")
+  {
+    STATIC_REQUIRE(note_value_code().get_bits() == 0);
+    STATIC_REQUIRE(decode(note_value_code()) == whole_note);
+  }
+
+  SECTION("fields")
+  {
+    constexpr auto code
+      = encode(_16th_note.with(tuplet::quintuplet).with(dot_count::_double));
+
+    STATIC_REQUIRE(code.get_exponent() == -4);
+    STATIC_REQUIRE(code.get_tuplet() == tuplet::quintuplet);
+    STATIC_REQUIRE(code.get_num_dots() == dot_count::_double);
+    STATIC_REQUIRE(note_value_code::from_bits(code.get_bits()) == code);
+  }
+
+  SECTION("lossless round trip")
+  {
+    for (auto exponent = note_value_code::min_exponent;
+         exponent <= note_value_code::max_exponent;
+         ++exponent)
+      for (auto count = 2; count <= 10; ++count)
+        for (auto dots = 0; dots <= 3; ++dots)
+        {
+          auto const nv
+            = note_value(power_of_2(power_of_2::from_exponent, exponent),
+                         static_cast<tuplet>(count),
+                         static_cast<dot_count>(dots));
+
+          if (!is_identical(decode(encode(nv)), nv))
+            FAIL("the note value did not survive a round trip");
+        }
+  }
+
+  SECTION("identical note values only")
+  {
+    STATIC_REQUIRE(whole_note.with(tuplet::sextuplet) == triplet_half_note);
+    STATIC_REQUIRE(encode(whole_note.with(tuplet::sextuplet))
+                   != encode(triplet_half_note));
+  }
+
+  SECTION("exponent out of range")
+  {
+    REQUIRE_THROWS_AS(encode(note_value(power_of_2(
+                        power_of_2::from_exponent,
+                        note_value_code::max_exponent + 1))),
+                      std::overflow_error);
+    REQUIRE_THROWS_AS(encode(note_value(power_of_2(
+                        power_of_2::from_exponent,
+                        note_value_code::min_exponent - 1))),
+                      std::overflow_error);
+  }
+
+  SECTION("bits that are not a code")
+  {
+    // The tuplet field holds the count minus 2, so 8 is the decuplet
+    STATIC_REQUIRE(note_value_code::from_bits(0x3 | 8u << 2).get_tuplet()
+                   == tuplet::decuplet);
+
+    for (auto field = 9u; field <= 0xFu; ++field)
+      REQUIRE_THROWS_AS(
+        note_value_code::from_bits(static_cast<std::uint16_t>(field << 2)),
+        std::invalid_argument);
+  }
+}
+
+TEST_CASE("packed_note_value_vector", "[note_value_code]")
+{
+  STATIC_REQUIRE(sizeof(note_value_code) == 2);
+
+  auto const note_values = std::vector<note_value> {
+    _8th_note, triplet_8th_note, quarter_note.with(dot_count::single),
+    _256th_note, octuple_whole_note.with(dot_count::triple)};
+
+  auto packed = packed_note_value_vector(note_values.begin(),
+                                         note_values.end());
+
+  SECTION("element access")
+  {
+    REQUIRE(packed.size() == note_values.size());
+    REQUIRE(packed.front() == _8th_note);
+    REQUIRE(packed.back() == octuple_whole_note.with(dot_count::triple));
+    REQUIRE(is_identical(packed[1], triplet_8th_note));
+    REQUIRE(packed.at(3) == _256th_note);
+    REQUIRE_THROWS_AS(packed.at(5), std::out_of_range);
+    REQUIRE(decode(packed.data()[2]) == quarter_note.with(dot_count::single));
+  }
+
+  SECTION("iteration")
+  {
+    REQUIRE(std::equal(packed.begin(),
+                       packed.end(),
+                       note_values.begin(),
+                       note_values.end(),
+                       is_identical));
+    REQUIRE(packed.end() - packed.begin() == 5);
+    REQUIRE(packed.begin()[4] == note_values[4]);
+    REQUIRE(*std::max_element(packed.begin(), packed.end())
+            == octuple_whole_note.with(dot_count::triple));
+  }
+
+  SECTION("modifiers")
+  {
+    packed.set(0, half_note);
+    packed.push_back(_32nd_note);
+
+    REQUIRE(packed.size() == 6);
+    REQUIRE(packed[0] == half_note);
+    REQUIRE(packed.back() == _32nd_note);
+
+    packed.pop_back();
+    REQUIRE(packed.size() == 5);
+
+    packed.clear();
+    REQUIRE(packed.empty());
+    REQUIRE(packed.begin() == packed.end());
+  }
+
+  SECTION("initializer list")
+  {
+    auto const list = packed_note_value_vector {whole_note, half_note};
+
+    REQUIRE(list.size() == 2);
+    REQUIRE(list[1] == half_note);
+  }
+}
@@ -0,0 +1,232 @@
+#define CATCH_CONFIG_MAIN
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include <catch2/catch.hpp>
+
+#include <cbb/note_value.hpp>
+
+#include <climits>
+#include <cstddef>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+
+using namespace cbb;
+
+
+namespace {
+
+
+// Whitespace separated "n/d" power of 2 durations, some unreduced, as read
+// from a text dump of a score
+std::string make_duration_text(std::size_t const size)
+{
+  constexpr char const* tokens[]
+    = {"1/4", "1/8", "2/16", "1/2", "1", "3/12", "1/16", "4/2", "1/32", "5/40"};
+
+  auto text = std::string();
+
+  for (std::size_t i = 0; i < size; ++i)
+  {
+    text += tokens[i % std::size(tokens)];
+    text += ' ';
+  }
+
+  return text;
+}
+
+std::vector<fraction> parse_durations(std::string const& text)
+{
+  auto durations = std::vector<fraction>();
+
+  for (auto first = text.data(), last = text.data() + text.size();
+       first != last;
+       ++first)
+  {
+    auto duration = fraction();
+    first = from_chars(first, last, duration).ptr;
+    durations.push_back(duration);
+  }
+
+  return durations;
+}
+
+// The detection this replaces: reduce, then scan every bit of the term
+int bit_scan_exponent(fraction const& value)
+{
+  auto const scan = [](fraction_rep_t const term) {
+    constexpr auto num_bits = static_cast<int>(sizeof(term) * CHAR_BIT - 1);
+
+    auto count = 0;
+    auto exponent = 0;
+
+    for (auto i = 0; i < num_bits; ++i)
+      if (((term >> i) & 1) != 0)
+      {
+        ++count;
+        exponent = i;
+      }
+
+    if (count != 1)
+      throw std::invalid_argument("not a power of 2");
+
+    return exponent;
+  };
+
+  auto const reduced = binary_reduce(value);
+
+  if (reduced.numerator() == 1)
+    return -scan(reduced.denominator());
+
+  if (reduced.denominator() == 1)
+    return scan(reduced.numerator());
+
+  throw std::invalid_argument("not a power of 2");
+}
+
+
+} // namespace
+
+
+TEST_CASE("Converting 10^6 parsed durations to power_of_2",
+          "[power_of_2][benchmark]")
+{
+  auto const text = make_duration_text(1'000'000);
+  auto const durations = parse_durations(text);
+
+  REQUIRE(durations.size() == 1'000'000);
+
+  for (std::size_t i = 0; i < 10; ++i)
+    REQUIRE(power_of_2(durations[i]).get_exponent()
+            == bit_scan_exponent(durations[i]));
+
+  BENCHMARK("reduce and bit scan")
+  {
+    auto checksum = 0;
+
+    for (auto const& duration : durations)
+      checksum += bit_scan_exponent(duration);
+
+    return checksum;
+  };
+
+  BENCHMARK("power_of_2(fraction)")
+  {
+    auto checksum = 0;
+
+    for (auto const& duration : durations)
+      checksum += power_of_2(duration).get_exponent();
+
+    return checksum;
+  };
+
+  BENCHMARK("try_make_power_of_2")
+  {
+    auto checksum = 0;
+
+    for (auto const& duration : durations)
+      if (auto const p = try_make_power_of_2(duration))
+        checksum += p->get_exponent();
+
+    return checksum;
+  };
+
+  BENCHMARK("from_chars and try_make_power_of_2")
+  {
+    auto checksum = 0;
+
+    for (auto first = text.data(), last = text.data() + text.size();
+         first != last;
+         ++first)
+    {
+      auto duration = fraction();
+      first = from_chars(first, last, duration).ptr;
+
+      if (auto const p = try_make_power_of_2(duration))
+        checksum += p->get_exponent();
+    }
+
+    return checksum;
+  };
+}
+
+TEST_CASE("Scaling 10^6 durations by powers of 2", "[power_of_2][benchmark]")
+{
+  auto const durations = parse_durations(make_duration_text(1'000'000));
+
+  auto note_values = std::vector<note_value>();
+  note_values.reserve(durations.size());
+
+  for (std::size_t i = 0; i < durations.size(); ++i)
+    note_values.emplace_back(
+      power_of_2(power_of_2::from_exponent, static_cast<int>(i % 9) - 6),
+      static_cast<tuplet>(i % 9 + 2),
+      static_cast<dot_count>(i % 4));
+
+  auto const scale = [](std::size_t const i) {
+    return power_of_2(power_of_2::from_exponent, static_cast<int>(i % 7) - 3);
+  };
+
+  BENCHMARK("get_value() then fraction multiply")
+  {
+    auto checksum = 0;
+
+    for (std::size_t i = 0; i < durations.size(); ++i)
+      checksum += (scale(i).get_value() * durations[i]).denominator();
+
+    return checksum;
+  };
+
+  BENCHMARK("power_of_2 * fraction")
+  {
+    auto checksum = 0;
+
+    for (std::size_t i = 0; i < durations.size(); ++i)
+      checksum += (scale(i) * durations[i]).denominator();
+
+    return checksum;
+  };
+
+  BENCHMARK("get_value() then fraction divide")
+  {
+    auto checksum = 0;
+
+    for (std::size_t i = 0; i < durations.size(); ++i)
+      checksum += (durations[i] / scale(i).get_value()).denominator();
+
+    return checksum;
+  };
+
+  BENCHMARK("fraction / power_of_2")
+  {
+    auto checksum = 0;
+
+    for (std::size_t i = 0; i < durations.size(); ++i)
+      checksum += (durations[i] / scale(i)).denominator();
+
+    return checksum;
+  };
+
+  BENCHMARK("relative_value by get_value() and fraction multiplies")
+  {
+    auto checksum = 0;
+
+    for (auto const& nv : note_values)
+      checksum += (nv.get_power_of_2().get_value()
+                   * tuplet_factor(nv.get_tuplet())
+                   * dot_augmentation(nv.get_num_dots()))
+                    .denominator();
+
+    return checksum;
+  };
+
+  BENCHMARK("relative_value by factor table and shift kernel")
+  {
+    auto checksum = 0;
+
+    for (auto const& nv : note_values)
+      checksum += detail::computed_relative_value(nv).denominator();
+
+    return checksum;
+  };
+}
@@ -3,6 +3,10 @@
 
 #include <cbb/power_of_2_constants.hpp>
 
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+
 
 using namespace cbb;
 using namespace ieme::fraction_literals;
@@ -34,9 +38,41 @@ TEST_CASE("power_of_2 construction", "[power_of_2]")
     {
       STATIC_REQUIRE(power_of_2(1 / 16_fr).get_exponent() == -4);
     }
+
+    SECTION("unreduced")
+    {
+      STATIC_REQUIRE(power_of_2(fraction(24, 3)).get_exponent() == 3);
+      STATIC_REQUIRE(power_of_2(fraction(-5, -80)).get_exponent() == -4);
+    }
+
+    SECTION("not a power of 2")
+    {
+      REQUIRE_THROWS_AS(power_of_2(fraction(0)), std::invalid_argument);
+      REQUIRE_THROWS_AS(power_of_2(fraction(3, 4)), std::invalid_argument);
+      REQUIRE_THROWS_AS(power_of_2(fraction(-1, 4)), std::invalid_argument);
+      REQUIRE_THROWS_AS(power_of_2(fraction(6)), std::invalid_argument);
+      REQUIRE_THROWS_AS(power_of_2(fraction(1, 0)), std::invalid_argument);
+    }
   }
 }
 
+TEST_CASE("try_make_power_of_2", "[power_of_2]")
+{
+  STATIC_REQUIRE(try_make_power_of_2(1 / 8_fr) == numbers::one_8th);
+  STATIC_REQUIRE(try_make_power_of_2(fraction(12, 3)) == numbers::_4);
+  STATIC_REQUIRE(try_make_power_of_2(fraction(-2, -1)) == numbers::_2);
+  STATIC_REQUIRE(
+    try_make_power_of_2(fraction(std::numeric_limits<int>::min(), -2))
+    == power_of_2(power_of_2::from_exponent, 30));
+
+  STATIC_REQUIRE_FALSE(try_make_power_of_2(fraction(0)));
+  STATIC_REQUIRE_FALSE(try_make_power_of_2(3 / 8_fr));
+  STATIC_REQUIRE_FALSE(try_make_power_of_2(fraction(-1, 8)));
+  STATIC_REQUIRE_FALSE(try_make_power_of_2(fraction(1, 0)));
+  STATIC_REQUIRE_FALSE(
+    try_make_power_of_2(fraction(std::numeric_limits<int>::min(), 2)));
+}
+
 TEST_CASE("power_of_2::get_value", "[power_of_2]")
 {
   STATIC_REQUIRE(numbers::one_8th.get_value() == 1 / 8_fr);
@@ -153,6 +189,54 @@ TEST_CASE("power_of_2 arithmetic operators", "[power_of_2]")
     STATIC_REQUIRE(numbers::_16 * numbers::one_quarter == numbers::_4);
     STATIC_REQUIRE(numbers::_16 * 1 / 3_fr == 16 / 3_fr);
     STATIC_REQUIRE(1 / 5_fr * numbers::one_half == 1 / 10_fr);
+
+    SECTION("factors of 2 cancel")
+    {
+      constexpr auto product = numbers::_4 * (3 / 8_fr);
+
+      STATIC_REQUIRE(product.numerator() == 3);
+      STATIC_REQUIRE(product.denominator() == 2);
+    }
+
+    SECTION("signs")
+    {
+      STATIC_REQUIRE(numbers::_2 * fraction(3, -4) == -3 / 2_fr);
+      STATIC_REQUIRE((numbers::_2 * fraction(3, -4)).denominator() > 0);
+      STATIC_REQUIRE(numbers::_2 * fraction(0) == 0);
+    }
+
+    SECTION("overflow")
+    {
+      auto const big = fraction(std::numeric_limits<int>::max() / 2 + 1);
+
+      REQUIRE_THROWS_AS(numbers::_2 * big, std::overflow_error);
+      REQUIRE_THROWS_AS(numbers::one_half * (1 / big), std::overflow_error);
+      REQUIRE_THROWS_AS(power_of_2(power_of_2::from_exponent, 40) * (1 / 3_fr),
+                        std::overflow_error);
+    }
+
+    SECTION("the minimum numerator")
+    {
+      constexpr auto min = std::numeric_limits<int>::min();
+      constexpr auto product = numbers::_2 * fraction(min, 4);
+
+      STATIC_REQUIRE(product.numerator() == min);
+      STATIC_REQUIRE(product.denominator() == 2);
+      STATIC_REQUIRE((numbers::_2 * fraction(min / 2, 3)).numerator() == min);
+
+      REQUIRE_THROWS_AS(numbers::_2 * fraction(-(min / 2), 3),
+                        std::overflow_error);
+      REQUIRE_THROWS_AS(numbers::_4 * fraction(min / 2, 3),
+                        std::overflow_error);
+    }
+
+    SECTION("the minimum exponent")
+    {
+      auto const p = power_of_2(power_of_2::from_exponent,
+                                std::numeric_limits<int>::min());
+
+      REQUIRE_THROWS_AS(p * (1 / 3_fr), std::overflow_error);
+    }
   }
 
   SECTION("operator/")
@@ -160,6 +244,19 @@ TEST_CASE("power_of_2 arithmetic operators", "[power_of_2]")
     STATIC_REQUIRE(numbers::_16 / numbers::one_half == numbers::_32);
     STATIC_REQUIRE(numbers::_8 / (1 / 3_fr) == 24);
     STATIC_REQUIRE(1 / 5_fr / numbers::one_quarter == 4 / 5_fr);
+    STATIC_REQUIRE(numbers::one_half / (-1 / 6_fr) == -3);
+
+    REQUIRE_THROWS_AS(1 / 3_fr / power_of_2(power_of_2::from_exponent, -31),
+                      std::overflow_error);
+
+    STATIC_REQUIRE(
+      (-1 / 3_fr / power_of_2(power_of_2::from_exponent, -31)).numerator()
+      == std::numeric_limits<int>::min());
+
+    REQUIRE_THROWS_AS(1 / 3_fr
+                        / power_of_2(power_of_2::from_exponent,
+                                     std::numeric_limits<int>::min()),
+                      std::overflow_error);
   }
 
   SECTION("operator%")
@@ -190,3 +287,29 @@ TEST_CASE("power_of_2 arithmetic operators", "[power_of_2]")
     STATIC_REQUIRE(p == numbers::_4);
   }
 }
+
+TEMPLATE_TEST_CASE("basic_power_of_2 representations",
+                   "[power_of_2]",
+                   std::int16_t,
+                   std::int64_t)
+{
+  using p2 = basic_power_of_2<TestType>;
+
+  STATIC_REQUIRE(p2(basic_fraction<TestType>(1, 64)).get_exponent() == -6);
+  STATIC_REQUIRE(numbers::one_8th_v<TestType> * numbers::_4_v<TestType>
+                 == numbers::one_half_v<TestType>);
+  STATIC_REQUIRE(numbers::_16_v<TestType> / numbers::one_4th_v<TestType>
+                 == p2(p2::from_exponent, 6));
+  STATIC_REQUIRE(numbers::one_32nd_v<TestType> < numbers::one_16th_v<TestType>);
+}
+
+#if defined(__SIZEOF_INT128__) && !defined(__STRICT_ANSI__)
+TEST_CASE("basic_power_of_2 with a 128-bit representation", "[power_of_2]")
+{
+  using p2 = basic_power_of_2<__int128>;
+
+  STATIC_REQUIRE(p2(p2::from_exponent, 100).get_exponent() == 100);
+  STATIC_REQUIRE(p2(p2::from_exponent, 100) * numbers::one_4th_v<__int128>
+                 == p2(p2::from_exponent, 98));
+}
+#endif
@@ -0,0 +1 @@
+#include <cbb/tick_domain.hpp>
@@ -0,0 +1,134 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include <cbb/note_value_constants.hpp>
+#include <cbb/tick_domain.hpp>
+
+#include <array>
+#include <unordered_set>
+#include <vector>
+
+
+using namespace cbb;
+using namespace ieme::fraction_literals;
+
+
+TEST_CASE("tick_domain construction", "[tick_domain]")
+{
+  STATIC_REQUIRE(tick_domain().get_resolution() == 1);
+  STATIC_REQUIRE(tick_domain(960).get_resolution() == 960);
+
+  REQUIRE_THROWS_AS(tick_domain(0), std::invalid_argument);
+  REQUIRE_THROWS_AS(tick_domain(-4), std::invalid_argument);
+}
+
+TEST_CASE("tick_domain projection", "[tick_domain]")
+{
+  constexpr auto domain = tick_domain(48);
+
+  SECTION("to ticks")
+  {
+    STATIC_REQUIRE(domain.to_ticks(3 / 4_fr) == 36);
+    STATIC_REQUIRE(domain.to_ticks(fraction(-1, 6)) == -8);
+    STATIC_REQUIRE(domain.to_ticks(fraction(10, 20)) == 24);
+    STATIC_REQUIRE(domain.to_ticks(fraction(5)) == 240);
+
+    REQUIRE_THROWS_AS(domain.to_ticks(fraction(1, 5)), std::invalid_argument);
+    REQUIRE_THROWS_AS(tick_domain(1LL << 62).to_ticks(fraction(4)),
+                      std::overflow_error);
+  }
+
+  SECTION("to fraction")
+  {
+    constexpr auto f = domain.to_fraction(36);
+
+    STATIC_REQUIRE(f.numerator() == 3);
+    STATIC_REQUIRE(f.denominator() == 4);
+    STATIC_REQUIRE(domain.to_fraction(-8) == fraction(-1, 6));
+    STATIC_REQUIRE(domain.to_fraction(0) == 0);
+
+    REQUIRE_THROWS_AS(domain.to_fraction(1LL << 40), std::overflow_error);
+  }
+
+  SECTION("ranges")
+  {
+    auto const fractions = std::vector<fraction> {1 / 4_fr, 1 / 3_fr, 7 / 8_fr};
+    auto ticks = std::vector<tick_t>(fractions.size());
+    auto round_trip = std::vector<fraction>(fractions.size());
+
+    domain.to_ticks(fractions.begin(), fractions.end(), ticks.begin());
+    domain.to_fractions(ticks.begin(), ticks.end(), round_trip.begin());
+
+    REQUIRE(ticks == std::vector<tick_t> {12, 16, 42});
+    REQUIRE(round_trip == fractions);
+  }
+}
+
+TEST_CASE("tick_domain common domain", "[tick_domain]")
+{
+  SECTION("of domains")
+  {
+    STATIC_REQUIRE(common_tick_domain(tick_domain(6), tick_domain(4))
+                   == tick_domain(12));
+
+    REQUIRE_THROWS_AS(
+      common_tick_domain(tick_domain(1LL << 62), tick_domain(3)),
+      std::overflow_error);
+  }
+
+  SECTION("of fractions")
+  {
+    constexpr auto fractions
+      = std::array {1 / 4_fr, fraction(2, 6), fraction(5, -8), fraction(3)};
+
+    STATIC_REQUIRE(common_tick_domain(fractions.begin(), fractions.end())
+                   == tick_domain(24));
+
+    auto const empty = std::vector<fraction>();
+
+    REQUIRE(common_tick_domain(empty.begin(), empty.end()) == tick_domain());
+  }
+
+  SECTION("of note values")
+  {
+    constexpr auto note_values
+      = std::array {quarter_note,
+                    triplet_8th_note,
+                    _16th_note.with(dot_count::single),
+                    half_note.with(tuplet::quintuplet)};
+
+    // 1/4, 1/12, 3/32 and 1/5
+    STATIC_REQUIRE(note_value_tick_domain(note_values.begin(),
+                                          note_values.end())
+                   == tick_domain(480));
+
+    constexpr auto one_2_40th = power_of_2(power_of_2::from_exponent, -40);
+    constexpr auto very_short
+      = std::array {note_value(one_2_40th, dot_count::triple)};
+
+    STATIC_REQUIRE(note_value_tick_domain(very_short.begin(), very_short.end())
+                   == tick_domain(1LL << 43));
+  }
+}
+
+TEST_CASE("tick_domain ticks order and hash like their fractions",
+          "[tick_domain]")
+{
+  auto const fractions = std::vector<fraction> {
+    5 / 8_fr, fraction(1, 3), fraction(-1, 2), fraction(2, 6), 7 / 8_fr};
+  auto const domain = common_tick_domain(fractions.begin(), fractions.end());
+
+  for (auto const& l : fractions)
+    for (auto const& r : fractions)
+    {
+      REQUIRE((l < r) == (domain.to_ticks(l) < domain.to_ticks(r)));
+      REQUIRE((l == r) == (domain.to_ticks(l) == domain.to_ticks(r)));
+    }
+
+  auto distinct = std::unordered_set<tick_t>();
+
+  for (auto const& f : fractions)
+    distinct.insert(domain.to_ticks(f));
+
+  REQUIRE(distinct.size() == 4);
+}
@@ -0,0 +1,130 @@
+#define CATCH_CONFIG_MAIN
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include <catch2/catch.hpp>
+
+#include <cbb/tied_note_values.hpp>
+
+#include <cstddef>
+#include <vector>
+
+
+using namespace cbb;
+
+
+namespace {
+
+
+// Quantized durations up to a double whole note on grids of 64ths, 16th
+// triplets and 16th quintuplets
+std::vector<fraction> make_durations(std::size_t const size)
+{
+  constexpr int denominators[] = {64, 24, 40};
+
+  auto durations = std::vector<fraction>();
+  durations.reserve(size);
+
+  for (std::size_t i = 0; i < size; ++i)
+  {
+    auto const denominator = denominators[i % std::size(denominators)];
+    auto const numerator = static_cast<int>((i * 7919) % (2 * denominator)) + 1;
+
+    durations.push_back(binary_reduce(fraction(numerator, denominator)));
+  }
+
+  return durations;
+}
+
+// The brute-force search this replaces: the largest note value of the
+// duration's tuplet that still fits, over every exponent and dot count
+template <typename OutputIt>
+OutputIt brute_force_tied_note_values(fraction duration, OutputIt d_first)
+{
+  auto const t = detail::tuplet_for_odd_denominator(
+    duration.denominator()
+    >> detail::count_trailing_zeros(duration.denominator()));
+
+  while (duration > 0)
+  {
+    auto best = note_value();
+    auto best_value = fraction(0);
+
+    for (auto exponent = 4; exponent >= -12; --exponent)
+      for (auto dots = 0; dots <= 3; ++dots)
+      {
+        auto const nv
+          = note_value(power_of_2(power_of_2::from_exponent, exponent),
+                       t,
+                       static_cast<dot_count>(dots));
+        auto const value = detail::computed_relative_value(nv);
+
+        if (compare(value, duration) <= 0 && compare(value, best_value) > 0)
+        {
+          best = nv;
+          best_value = value;
+        }
+      }
+
+    *d_first = best;
+    ++d_first;
+    duration = binary_reduce(duration - best_value);
+  }
+
+  return d_first;
+}
+
+
+} // namespace
+
+
+TEST_CASE("Tying 10^6 quantized durations", "[tied_note_values][benchmark]")
+{
+  auto const durations = make_durations(1'000'000);
+
+  auto note_values = std::vector<note_value>();
+  note_values.reserve(16);
+
+  BENCHMARK("brute-force search")
+  {
+    auto count = std::size_t(0);
+
+    for (auto const& duration : durations)
+    {
+      note_values.clear();
+      brute_force_tied_note_values(duration, std::back_inserter(note_values));
+      count += note_values.size();
+    }
+
+    return count;
+  };
+
+  BENCHMARK("tied_note_values")
+  {
+    auto count = std::size_t(0);
+
+    for (auto const& duration : durations)
+    {
+      note_values.clear();
+      tied_note_values(duration, std::back_inserter(note_values));
+      count += note_values.size();
+    }
+
+    return count;
+  };
+
+  auto context = tie_context();
+  context.beat = fraction(1, 4);
+
+  BENCHMARK("tied_note_values split at quarter note beats")
+  {
+    auto count = std::size_t(0);
+
+    for (auto const& duration : durations)
+    {
+      note_values.clear();
+      tied_note_values(duration, std::back_inserter(note_values), context);
+      count += note_values.size();
+    }
+
+    return count;
+  };
+}
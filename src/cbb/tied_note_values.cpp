@@ -0,0 +1 @@
+#include <cbb/tied_note_values.hpp>
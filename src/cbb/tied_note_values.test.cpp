@@ -0,0 +1,147 @@
+#define CATCH_CONFIG_MAIN
+#include <catch2/catch.hpp>
+
+#include <cbb/note_value_constants.hpp>
+#include <cbb/tied_note_values.hpp>
+
+#include <stdexcept>
+#include <vector>
+
+
+using namespace cbb;
+using namespace ieme::fraction_literals;
+
+
+namespace {
+
+fraction sum(std::vector<note_value> const& note_values)
+{
+  auto result = fraction(0);
+
+  for (auto const& nv : note_values)
+    result = binary_reduce(result + relative_value(nv));
+
+  return result;
+}
+
+} // namespace
+
+
+TEST_CASE("tied_note_values without a metric context", "[tied_note_values]")
+{
+  SECTION("a single note value")
+  {
+    REQUIRE(tied_note_values(1 / 4_fr) == std::vector {quarter_note});
+    REQUIRE(tied_note_values(3 / 8_fr)
+            == std::vector {quarter_note.with(dot_count::single)});
+    REQUIRE(tied_note_values(15 / 16_fr)
+            == std::vector {half_note.with(dot_count::triple)});
+    REQUIRE(tied_note_values(1 / 12_fr) == std::vector {triplet_8th_note});
+    REQUIRE(tied_note_values(3 / 40_fr)
+            == std::vector {
+              _8th_note.with(tuplet::quintuplet).with(dot_count::single)});
+  }
+
+  SECTION("ties, largest first")
+  {
+    REQUIRE(tied_note_values(5 / 8_fr)
+            == std::vector {half_note, _8th_note});
+    REQUIRE(tied_note_values(9 / 4_fr)
+            == std::vector {double_whole_note, quarter_note});
+    REQUIRE(tied_note_values(5 / 12_fr)
+            == std::vector {triplet_half_note, triplet_8th_note});
+  }
+
+  SECTION("the largest note value first, not the fewest note values")
+  {
+    REQUIRE(tied_note_values(21 / 16_fr)
+            == std::vector {whole_note, quarter_note, _16th_note});
+  }
+
+  SECTION("dots are limited")
+  {
+    auto context = tie_context();
+    context.max_dots = dot_count::none;
+
+    REQUIRE(tied_note_values(7 / 8_fr, context)
+            == std::vector {half_note, quarter_note, _8th_note});
+
+    context.max_dots = dot_count::single;
+
+    REQUIRE(tied_note_values(7 / 8_fr, context)
+            == std::vector {half_note.with(dot_count::single), _8th_note});
+  }
+
+  SECTION("every sum is the duration")
+  {
+    for (auto denominator : {1, 2, 3, 5, 7, 9, 12, 20, 28, 36, 64, 96, 320})
+      for (auto numerator = 1; numerator <= 200; ++numerator)
+      {
+        auto const duration = binary_reduce(fraction(numerator, denominator));
+        auto const note_values = tied_note_values(duration);
+
+        REQUIRE(sum(note_values) == duration);
+      }
+  }
+
+  SECTION("invalid durations")
+  {
+    REQUIRE_THROWS_AS(tied_note_values(fraction(0)), std::invalid_argument);
+    REQUIRE_THROWS_AS(tied_note_values(-1 / 4_fr), std::invalid_argument);
+    REQUIRE_THROWS_AS(tied_note_values(1 / 15_fr), std::invalid_argument);
+    REQUIRE_THROWS_AS(tied_note_values(1 / 11_fr), std::invalid_argument);
+  }
+}
+
+TEST_CASE("tied_note_values with a metric context", "[tied_note_values]")
+{
+  auto context = tie_context();
+  context.beat = 1 / 4_fr;
+
+  SECTION("within a beat")
+  {
+    REQUIRE(tied_note_values(1 / 4_fr, context) == std::vector {quarter_note});
+  }
+
+  SECTION("across beats")
+  {
+    context.onset = 1 / 8_fr;
+
+    REQUIRE(tied_note_values(1 / 2_fr, context)
+            == std::vector {_8th_note, quarter_note, _8th_note});
+  }
+
+  SECTION("output iterator")
+  {
+    context.onset = 3 / 8_fr;
+
+    auto note_values = std::vector<note_value>();
+    tied_note_values(3 / 4_fr, std::back_inserter(note_values), context);
+
+    REQUIRE(note_values
+            == std::vector {_8th_note, quarter_note, quarter_note, _8th_note});
+  }
+
+  SECTION("tuplets")
+  {
+    context.onset = 1 / 6_fr;
+
+    REQUIRE(tied_note_values(1 / 6_fr, context)
+            == std::vector {triplet_8th_note, triplet_8th_note});
+  }
+
+  SECTION("a tuplet for each beat")
+  {
+    auto const note_values = tied_note_values(1 / 3_fr, context);
+
+    REQUIRE(note_values == std::vector {quarter_note, triplet_8th_note});
+    REQUIRE(note_values[0].get_tuplet() == tuplet::duplet);
+    REQUIRE(note_values[1].get_tuplet() == tuplet::triplet);
+  }
+
+  SECTION("invalid durations")
+  {
+    REQUIRE_THROWS_AS(tied_note_values(fraction(0), context),
+                      std::invalid_argument);
+  }
+}